@@ -0,0 +1,378 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+
+/**
+ * Microbenchmarks of the Murxla core data structures.
+ *
+ * Use --benchmark_format=json or --benchmark_out=<file> to export the results
+ * in JSON format for tracking regressions over time.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "dd.hpp"
+#include "fsm.hpp"
+#include "murxla.hpp"
+#include "options.hpp"
+#include "rng.hpp"
+#include "solver/mock/mock_solver.hpp"
+#include "solver/solver_profile.hpp"
+#include "solver_option.hpp"
+#include "statistics.hpp"
+#include "term_db.hpp"
+#include "util.hpp"
+
+using namespace murxla;
+
+namespace {
+
+/** An output stream without buffer, discards all trace output. */
+std::ostream s_null_out(nullptr);
+
+/** Create 'n' Boolean inputs with the mock solver. */
+std::vector<Term>
+mk_terms(mock::MockSolver& solver, size_t n)
+{
+  Sort sort = solver.mk_sort(SORT_BOOL);
+  sort->set_kind(SORT_BOOL);
+  std::vector<Term> res;
+  for (size_t i = 0; i < n; ++i)
+  {
+    res.push_back(solver.mk_const(sort, ""));
+  }
+  return res;
+}
+
+/** Create a random error message in the style of a failed assertion. */
+std::string
+mk_error(RNGenerator& rng)
+{
+  return "murxla: src/" + rng.pick_simple_symbol(12) + ".cpp:"
+         + rng.pick_dec_int_string(3) + ": void murxla::"
+         + rng.pick_simple_symbol(24) + "(): Assertion `"
+         + rng.pick_simple_symbol(16) + "' failed.\n";
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+/* TermRefs                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static void
+BM_TermRefs_add(benchmark::State& state)
+{
+  SolverSeedGenerator sng(0);
+  mock::MockSolver solver(sng);
+  solver.new_solver();
+  std::vector<Term> terms = mk_terms(solver, state.range(0));
+
+  for (auto _ : state)
+  {
+    TermRefs refs(1);
+    for (const Term& t : terms)
+    {
+      refs.add(t, 0);
+    }
+    benchmark::DoNotOptimize(refs.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TermRefs_add)->RangeMultiplier(8)->Range(8, 4096);
+
+static void
+BM_TermRefs_pick(benchmark::State& state)
+{
+  SolverSeedGenerator sng(0);
+  RNGenerator rng(0);
+  mock::MockSolver solver(sng);
+  solver.new_solver();
+  TermRefs refs(1);
+  for (const Term& t : mk_terms(solver, state.range(0)))
+  {
+    refs.add(t, 0);
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(refs.pick(rng));
+  }
+}
+BENCHMARK(BM_TermRefs_pick)->RangeMultiplier(8)->Range(8, 4096);
+
+static void
+BM_TermRefs_push_pop(benchmark::State& state)
+{
+  SolverSeedGenerator sng(0);
+  mock::MockSolver solver(sng);
+  solver.new_solver();
+  std::vector<Term> terms = mk_terms(solver, state.range(0));
+  TermRefs refs(1);
+
+  for (auto _ : state)
+  {
+    refs.push();
+    for (const Term& t : terms)
+    {
+      refs.add(t, 1);
+    }
+    refs.pop();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TermRefs_push_pop)->RangeMultiplier(8)->Range(8, 4096);
+
+/* -------------------------------------------------------------------------- */
+/* RNGenerator                                                                */
+/* -------------------------------------------------------------------------- */
+
+static void
+BM_RNGenerator_pick_weighted(benchmark::State& state)
+{
+  RNGenerator rng(0);
+  std::vector<uint32_t> weights;
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    weights.push_back(rng.pick<uint32_t>(1, 100));
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(rng.pick_weighted<uint32_t>(weights));
+  }
+}
+BENCHMARK(BM_RNGenerator_pick_weighted)->RangeMultiplier(4)->Range(4, 256);
+
+static void
+BM_RNGenerator_pick_from_set(benchmark::State& state)
+{
+  RNGenerator rng(0);
+  std::unordered_set<uint64_t> set;
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    set.insert(rng.pick<uint64_t>());
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(
+        rng.pick_from_set<std::unordered_set<uint64_t>, uint64_t>(set));
+  }
+}
+BENCHMARK(BM_RNGenerator_pick_from_set)->RangeMultiplier(8)->Range(8, 4096);
+
+/* -------------------------------------------------------------------------- */
+/* Trace parsing                                                              */
+/* -------------------------------------------------------------------------- */
+
+static void
+BM_tokenize(benchmark::State& state)
+{
+  std::vector<std::string> lines = {
+      "81342 mk-const s2 \"_x1\"",
+      "80989 mk-term OP_BV_SHL SORT_BV 2 t12 t18",
+      "39813 mk-term OP_BV_EXTRACT SORT_BV 1 t14 2 7 3",
+      "12295 mk-value s3 \"1001110100101101\" 2",
+      "23552 check-sat-assuming 3 t21 t35 t8",
+      "98924 mk-sort SORT_DT 1 \"_dt0\" 0 2 \"_cons1\" 2 \"_sel2\" s1 "
+      "\"_sel3\" s\"_dt0\" \"_cons4\" 0",
+  };
+
+  for (auto _ : state)
+  {
+    for (const auto& line : lines)
+    {
+      benchmark::DoNotOptimize(tokenize(line));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_tokenize);
+
+/* -------------------------------------------------------------------------- */
+/* Error deduplication                                                        */
+/* -------------------------------------------------------------------------- */
+
+static void
+BM_Murxla_add_error(benchmark::State& state)
+{
+  std::filesystem::path tmp_dir = std::filesystem::temp_directory_path();
+  statistics::Statistics* stats = statistics::Statistics::create(1);
+  SolverOptions solver_options;
+  Options options;
+  options.solver = SOLVER_MOCK;
+  Murxla::ErrorMap errors, timeouts;
+  Murxla murxla(
+      stats, options, &solver_options, &errors, &timeouts, tmp_dir.string());
+
+  RNGenerator rng(0);
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    murxla.add_error(mk_error(rng), 0);
+  }
+
+  /* Each new error is compared against all stored errors. */
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    std::string err = mk_error(rng);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(murxla.add_error(err, 0));
+    state.PauseTiming();
+    errors.erase(err);
+    state.ResumeTiming();
+  }
+  statistics::Statistics::destroy(stats);
+}
+BENCHMARK(BM_Murxla_add_error)->RangeMultiplier(4)->Range(16, 1024);
+
+/* -------------------------------------------------------------------------- */
+/* Delta debugging                                                            */
+/* -------------------------------------------------------------------------- */
+
+static void
+BM_DD_minimize_lines(benchmark::State& state)
+{
+  std::filesystem::path tmp_dir = std::filesystem::temp_directory_path();
+  statistics::Statistics* stats = statistics::Statistics::create(1);
+  SolverOptions solver_options;
+  Options options;
+  options.solver = SOLVER_MOCK;
+  Murxla::ErrorMap errors, timeouts;
+  Murxla murxla(
+      stats, options, &solver_options, &errors, &timeouts, tmp_dir.string());
+
+  /* A trace of constants, every other line asserts the previous constant. */
+  size_t n_lines = static_cast<size_t>(state.range(0));
+  std::vector<std::vector<std::string>> lines = {
+      {"1 new"}, {"2 mk-sort SORT_BOOL", "return s1"}};
+  for (size_t i = 2; i < n_lines; ++i)
+  {
+    std::string seed = std::to_string(i + 1);
+    if (i % 2 == 0)
+    {
+      lines.push_back({seed + " mk-const s1 \"_x" + std::to_string(i) + "\"",
+                       "return t" + std::to_string(i)});
+    }
+    else
+    {
+      lines.push_back({seed + " assert-formula t" + std::to_string(i - 1)});
+    }
+  }
+
+  /* The synthetic failure is triggered by four of the assertions. */
+  RNGenerator rng(0);
+  std::vector<size_t> culprits;
+  while (culprits.size() < 4)
+  {
+    size_t idx = rng.pick<size_t>(1, n_lines / 2 - 1) * 2 + 1;
+    if (std::find(culprits.begin(), culprits.end(), idx) == culprits.end())
+    {
+      culprits.push_back(idx);
+    }
+  }
+  std::sort(culprits.begin(), culprits.end());
+  /* Candidates preserve the order of the trace lines. */
+  DD::TestFunction test = [&culprits](const auto& lines, const auto& superset) {
+    return std::includes(
+        superset.begin(), superset.end(), culprits.begin(), culprits.end());
+  };
+
+  /* Discard the progress messages of the delta debugger. */
+  std::streambuf* cout_buf = std::cout.rdbuf(s_null_out.rdbuf());
+  size_t n_reduced         = 0;
+  for (auto _ : state)
+  {
+    DD dd(&murxla, 0);
+    dd.set_test_function(test);
+    std::vector<size_t> included_lines(n_lines);
+    std::iota(included_lines.begin(), included_lines.end(), 0);
+    dd.minimize_lines(RESULT_ERROR, lines, included_lines);
+    n_reduced = included_lines.size();
+  }
+  std::cout.rdbuf(cout_buf);
+  std::cout.clear();
+  state.counters["reduced_lines"] = static_cast<double>(n_reduced);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  statistics::Statistics::destroy(stats);
+}
+BENCHMARK(BM_DD_minimize_lines)->RangeMultiplier(4)->Range(64, 4096);
+
+/* -------------------------------------------------------------------------- */
+/* SolverManager                                                              */
+/* -------------------------------------------------------------------------- */
+
+static void
+BM_SolverManager_pick_op_kind(benchmark::State& state)
+{
+  SolverSeedGenerator sng(0);
+  RNGenerator rng(0);
+  mock::MockSolver* solver = new mock::MockSolver(sng);
+  SolverProfile profile(solver->get_profile());
+  SolverOptions solver_options;
+  statistics::Statistics* stats = statistics::Statistics::create(1);
+
+  /* All theories supported by the solver are enabled. */
+  FSM fsm(rng,
+          sng,
+          solver,
+          profile,
+          s_null_out,
+          solver_options,
+          false,
+          true,
+          0,
+          false,
+          false,
+          "",
+          stats,
+          {},
+          {},
+          {},
+          false);
+  fsm.configure();
+  SolverManager& smgr = fsm.get_smgr();
+  solver->new_solver();
+
+  /* Add one input of each basic sort kind to enable operators. */
+  std::vector<std::pair<SortKind, uint32_t>> sort_kinds = {
+      {SORT_BOOL, 0},
+      {SORT_INT, 0},
+      {SORT_REAL, 0},
+      {SORT_RM, 0},
+      {SORT_STRING, 0},
+      {SORT_REGLAN, 0},
+      {SORT_BV, 32},
+  };
+  for (const auto& [kind, size] : sort_kinds)
+  {
+    Sort sort = size ? solver->mk_sort(kind, size) : solver->mk_sort(kind);
+    smgr.add_sort(sort, kind);
+    Term term = solver->mk_const(sort, "");
+    smgr.add_input(term, sort, kind);
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(smgr.pick_op_kind());
+  }
+  statistics::Statistics::destroy(stats);
+}
+BENCHMARK(BM_SolverManager_pick_op_kind);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,265 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+
+/**
+ * End-to-end throughput benchmark of Murxla itself.
+ *
+ * Runs a fixed set of seeds in continuous-mode configuration (forked test
+ * runs with time limit, no tracing) against the mock solver (or any other
+ * configured solver) and reports throughput, allocations per action and the
+ * time spent per action kind.  Exits with an error if any of the runs
+ * failed, since the numbers of truncated runs are not comparable.
+ */
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "except.hpp"
+#include "murxla.hpp"
+#include "options.hpp"
+#include "rng.hpp"
+#include "solver_option.hpp"
+#include "statistics.hpp"
+#include "util.hpp"
+
+/* -------------------------------------------------------------------------- */
+/* Allocation counting                                                        */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+/**
+ * The number of allocations via operator new.  Allocated in shared memory to
+ * include the allocations of the forked test run processes.
+ */
+std::atomic<uint64_t>* s_num_allocs = nullptr;
+}  // namespace
+
+void*
+operator new(std::size_t size)
+{
+  if (s_num_allocs) s_num_allocs->fetch_add(1, std::memory_order_relaxed);
+  void* res = std::malloc(size == 0 ? 1 : size);
+  if (res == nullptr) throw std::bad_alloc();
+  return res;
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t size) noexcept
+{
+  (void) size;
+  std::free(ptr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+using namespace murxla;
+
+namespace {
+
+#define MURXLA_BENCH_USAGE                                                     \
+  "usage:\n"                                                                   \
+  "  murxla-bench [options]\n"                                                 \
+  "\n"                                                                         \
+  "  -h, --help                 print this message and exit\n"                 \
+  "  -n, --runs <int>           number of test runs (default: 100)\n"          \
+  "  -s, --seed <int>           seed for the seed generator (default: 0)\n"    \
+  "  -t, --time <double>        time limit per test run\n"                     \
+  "  --solver <solver>          solver to benchmark (default: mock)\n"         \
+  "  --stats                    print statistics\n"
+
+void
+check_next_arg(const std::string& option, int i, int argc)
+{
+  MURXLA_EXIT_ERROR(i >= argc)
+      << "missing argument to option '" << option << "'";
+}
+
+std::string
+format_time(double seconds)
+{
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3) << seconds << "s";
+  return ss.str();
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t num_runs = 100;
+  uint64_t seed     = 0;
+  bool print_stats  = false;
+  Options options;
+  options.solver = SOLVER_MOCK;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    if (arg == "-h" || arg == "--help")
+    {
+      std::cout << MURXLA_BENCH_USAGE;
+      return 0;
+    }
+    else if (arg == "-n" || arg == "--runs")
+    {
+      check_next_arg(arg, ++i, argc);
+      num_runs = str_to_uint32(argv[i]);
+    }
+    else if (arg == "-s" || arg == "--seed")
+    {
+      check_next_arg(arg, ++i, argc);
+      seed = str_to_uint64(argv[i]);
+    }
+    else if (arg == "-t" || arg == "--time")
+    {
+      check_next_arg(arg, ++i, argc);
+      options.time = std::stod(argv[i]);
+    }
+    else if (arg == "--solver")
+    {
+      check_next_arg(arg, ++i, argc);
+      options.solver = argv[i];
+    }
+    else if (arg == "--stats")
+    {
+      print_stats = true;
+    }
+    else
+    {
+      MURXLA_EXIT_ERROR(true) << "unknown option '" << arg << "'";
+    }
+  }
+
+  void* mem = mmap(nullptr,
+                   sizeof(std::atomic<uint64_t>),
+                   PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS,
+                   -1,
+                   0);
+  MURXLA_EXIT_ERROR(mem == MAP_FAILED)
+      << "failed to map shared memory for allocation counter";
+  s_num_allocs = new (mem) std::atomic<uint64_t>(0);
+
+  std::filesystem::path tmp_dir = std::filesystem::temp_directory_path();
+  tmp_dir /= "murxla-bench-" + std::to_string(getpid());
+  std::filesystem::create_directory(tmp_dir);
+
+  statistics::Statistics* stats = statistics::Statistics::create(1);
+  SolverOptions solver_options;
+  Murxla::ErrorMap errors, timeouts;
+  uint32_t num_errors = 0, num_timeouts = 0;
+  uint64_t num_allocs = 0;
+  double time         = 0;
+
+  try
+  {
+    Murxla murxla(
+        stats, options, &solver_options, &errors, &timeouts, tmp_dir.string());
+    SeedGenerator sg(seed);
+
+    uint64_t allocs_start = s_num_allocs->load();
+    double start_time     = get_cur_wall_time();
+    for (uint32_t i = 0; i < num_runs; ++i)
+    {
+      Result res = murxla.run(sg.next(),
+                              options.time,
+                              DEVNULL,
+                              DEVNULL,
+                              "",
+                              "",
+                              true,
+                              true,
+                              Murxla::TraceMode::NONE);
+      if (res == RESULT_ERROR) ++num_errors;
+      if (res == RESULT_TIMEOUT) ++num_timeouts;
+    }
+    time       = get_cur_wall_time() - start_time;
+    num_allocs = s_num_allocs->load() - allocs_start;
+  }
+  catch (MurxlaException& e)
+  {
+    MURXLA_EXIT_ERROR(true) << e.get_msg();
+  }
+
+  nlohmann::json j = stats->to_json();
+  uint64_t num_actions = 0, actions_ns = 0;
+  std::vector<std::pair<std::string, uint64_t>> phases;
+  for (const auto& [kind, action] : j["actions"].items())
+  {
+    uint64_t total_ns = action["latency"]["total_ns"];
+    num_actions += action["count"].get<uint64_t>();
+    actions_ns += total_ns;
+    phases.emplace_back(kind, total_ns);
+  }
+  std::sort(phases.begin(), phases.end(), [](const auto& a, const auto& b) {
+    return a.second > b.second;
+  });
+  double actions_time = static_cast<double>(actions_ns) / 1e9;
+  phases.emplace_back("other (fork, setup, fsm)",
+                      time > actions_time
+                          ? static_cast<uint64_t>((time - actions_time) * 1e9)
+                          : 0);
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "solver:        " << options.solver << std::endl;
+  std::cout << "runs:          " << num_runs << std::endl;
+  std::cout << "errors:        " << num_errors << std::endl;
+  std::cout << "timeouts:      " << num_timeouts << std::endl;
+  std::cout << "time:          " << format_time(time) << std::endl;
+  std::cout << "runs/s:        " << num_runs / time << std::endl;
+  std::cout << "actions:       " << num_actions << std::endl;
+  std::cout << "actions/s:     " << static_cast<double>(num_actions) / time
+            << std::endl;
+  std::cout << "allocs/action: "
+            << (num_actions ? static_cast<double>(num_allocs)
+                                  / static_cast<double>(num_actions)
+                            : 0)
+            << std::endl;
+  std::cout << std::endl << "Time per phase:" << std::endl;
+  for (const auto& [phase, ns] : phases)
+  {
+    double t = static_cast<double>(ns) / 1e9;
+    std::cout << "  " << std::left << std::setw(28) << phase << std::right
+              << std::setw(10) << format_time(t) << std::setw(8)
+              << (time > 0 ? 100 * t / time : 0) << "%" << std::endl;
+  }
+
+  if (print_stats)
+  {
+    std::cout << std::endl;
+    stats->print();
+  }
+
+  statistics::Statistics::destroy(stats);
+  std::filesystem::remove_all(tmp_dir);
+
+  /* Numbers of truncated runs are meaningless, errors must be fixed first. */
+  MURXLA_EXIT_ERROR(num_errors > 0)
+      << num_errors << " of " << num_runs << " runs failed";
+  return 0;
+}
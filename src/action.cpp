@@ -534,7 +534,7 @@ ActionMkSort::generate()
   SortKind kind = d_smgr.pick_sort_kind_data().d_kind;
   RNGenerator::Choice pick;
 
-  ++d_smgr.d_mbt_stats->d_sorts[kind];
+  ++d_smgr.d_mbt_stats->shard().d_sorts[kind];
 
   switch (kind)
   {
@@ -805,7 +805,7 @@ ActionMkSort::generate()
     default: assert(false);
   }
 
-  ++d_smgr.d_mbt_stats->d_sorts_ok[kind];
+  ++d_smgr.d_mbt_stats->shard().d_sorts_ok[kind];
 
   return true;
 }
@@ -850,8 +850,11 @@ ActionMkSort::untrace(const std::vector<std::string>& tokens)
       break;
 
     case SORT_BV:
+      /* Bit-vector sorts are also created for floating-point arguments when
+       * THEORY_BV is not enabled (see generate()). */
       MURXLA_CHECK_TRACE(theories.find(THEORY_ALL) != theories.end()
-                         || theories.find(THEORY_BV) != theories.end())
+                         || theories.find(THEORY_BV) != theories.end()
+                         || theories.find(THEORY_FP) != theories.end())
           << "solver does not support theory of bit-vectors";
       MURXLA_CHECK_TRACE_NTOKENS_OF_SORT(2, n_tokens, kind);
       res = run(kind, str_to_uint32(tokens[1]));
@@ -1336,7 +1339,7 @@ ActionMkTerm::generate(Op::Kind kind)
     sort_kind = *sort_kinds.begin();
   }
 
-  ++d_smgr.d_mbt_stats->d_ops[op.d_id];
+  ++d_smgr.d_mbt_stats->shard().d_ops[op.d_id];
 
   if (kind == Op::DT_APPLY_CONS)
   {
@@ -1902,7 +1905,7 @@ ActionMkTerm::generate(Op::Kind kind)
     run(kind, sort_kind, args, indices);
   }
 
-  ++d_smgr.d_mbt_stats->d_ops_ok[op.d_id];
+  ++d_smgr.d_mbt_stats->shard().d_ops_ok[op.d_id];
 
   return true;
 }
@@ -2064,7 +2067,7 @@ ActionMkTerm::generate()
     assert(sort_kind != SORT_ANY);
     run(kind, sort_kind, args, {});
 
-    ++d_smgr.d_mbt_stats->d_ops[op.d_id];
+    ++d_smgr.d_mbt_stats->shard().d_ops[op.d_id];
     return true;
   }
   return generate(kind);
@@ -2167,6 +2170,8 @@ ActionMkTerm::run(Op::Kind kind,
   }
   MURXLA_TRACE << get_kind() << trace_str.str();
   reset_sat();
+  uint64_t op_id = d_smgr.get_op(kind).d_id;
+  d_smgr.d_mbt_stats->shard().set_cur_op(op_id);
 
   std::vector<Term> bargs;
   /* Note: We pop the variable scopes in run() instead of generate() so that we
@@ -2186,7 +2191,12 @@ ActionMkTerm::run(Op::Kind kind,
     }
   }
 
-  Term res = d_solver.mk_term(kind, args, indices);
+  Term res;
+  {
+    statistics::ScopedTimer timer(
+        d_smgr.d_mbt_stats->shard().d_op_times[op_id]);
+    res = d_solver.mk_term(kind, args, indices);
+  }
   // MURXLA_TEST(res->get_sort() == nullptr
   //             || d_solver.get_sort(res, sort_kind)->equals(res->get_sort()));
 
@@ -2235,8 +2245,15 @@ ActionMkTerm::run(Op::Kind kind,
   trace_str << " " << args.size() << args;
   MURXLA_TRACE << get_kind() << trace_str.str();
   reset_sat();
+  uint64_t op_id = d_smgr.get_op(kind).d_id;
+  d_smgr.d_mbt_stats->shard().set_cur_op(op_id);
 
-  Term res = d_solver.mk_term(kind, str_args, args);
+  Term res;
+  {
+    statistics::ScopedTimer timer(
+        d_smgr.d_mbt_stats->shard().d_op_times[op_id]);
+    res = d_solver.mk_term(kind, str_args, args);
+  }
   d_smgr.add_term(res, sort_kind, args);
   Sort res_sort = res->get_sort();
 
@@ -2262,6 +2279,8 @@ ActionMkTerm::run(Op::Kind kind,
   trace_str << " " << args.size() << args;
   MURXLA_TRACE << get_kind() << trace_str.str();
   reset_sat();
+  uint64_t op_id = d_smgr.get_op(kind).d_id;
+  d_smgr.d_mbt_stats->shard().set_cur_op(op_id);
 
   /* Note: We pop the variable scopes in run instead of generate so that we
    *       correctly handle this case for untracing. */
@@ -2273,7 +2292,12 @@ ActionMkTerm::run(Op::Kind kind,
     }
   }
 
-  Term res = d_solver.mk_term(kind, sort, str_args, args);
+  Term res;
+  {
+    statistics::ScopedTimer timer(
+        d_smgr.d_mbt_stats->shard().d_op_times[op_id]);
+    res = d_solver.mk_term(kind, sort, str_args, args);
+  }
   /* We do not add match case terms since they are specifically created for
    * creating a match term and should not be used in any other terms. */
   d_smgr.add_term(res, sort_kind, args);
@@ -3300,7 +3324,10 @@ ActionCheckSat::run()
 {
   MURXLA_TRACE << get_kind();
   reset_sat();
-  d_smgr.report_result(d_solver.check_sat());
+  double start       = get_cur_wall_time();
+  Solver::Result res = d_solver.check_sat();
+  d_smgr.check_perf(get_kind(), get_cur_wall_time() - start);
+  d_smgr.report_result(res);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3354,7 +3381,10 @@ ActionCheckSatAssuming::run(const std::vector<Term>& assumptions)
   {
     d_smgr.add_assumption(t);
   }
-  d_smgr.report_result(d_solver.check_sat_assuming(assumptions));
+  double start       = get_cur_wall_time();
+  Solver::Result res = d_solver.check_sat_assuming(assumptions);
+  d_smgr.check_perf(get_kind(), get_cur_wall_time() - start);
+  d_smgr.report_result(res);
 }
 
 /* -------------------------------------------------------------------------- */
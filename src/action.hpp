@@ -551,15 +551,15 @@ class ActionMkSort : public Action
 
   std::vector<uint32_t> d_n_args_weights;
 
-  SortKindSet d_exclude_array_element_sort_kinds;
-  SortKindSet d_exclude_array_index_sort_kinds;
-  SortKindSet d_exclude_bag_element_sort_kinds;
-  SortKindSet d_exclude_dt_sel_codomain_sort_kinds;
-  SortKindSet d_exclude_fun_sort_codomain_sort_kinds;
-  SortKindSet d_exclude_fun_sort_domain_sort_kinds;
-  SortKindSet d_exclude_seq_element_sort_kinds;
-  SortKindSet d_exclude_set_element_sort_kinds;
-  SortKindSet d_exclude_sort_param_sort_kinds;
+  const SortKindSet& d_exclude_array_element_sort_kinds;
+  const SortKindSet& d_exclude_array_index_sort_kinds;
+  const SortKindSet& d_exclude_bag_element_sort_kinds;
+  const SortKindSet& d_exclude_dt_sel_codomain_sort_kinds;
+  const SortKindSet& d_exclude_fun_sort_codomain_sort_kinds;
+  const SortKindSet& d_exclude_fun_sort_domain_sort_kinds;
+  const SortKindSet& d_exclude_seq_element_sort_kinds;
+  const SortKindSet& d_exclude_set_element_sort_kinds;
+  const SortKindSet& d_exclude_sort_param_sort_kinds;
 };
 
 /** The action to create a term. */
@@ -620,10 +620,10 @@ class ActionMkTerm : public Action
 
   std::vector<uint32_t> d_n_args_weights;
 
-  SortKindSet d_exclude_bag_element_sort_kinds;
-  SortKindSet d_exclude_dt_match_sort_kinds;
-  SortKindSet d_exclude_seq_element_sort_kinds;
-  SortKindSet d_exclude_set_element_sort_kinds;
+  const SortKindSet& d_exclude_bag_element_sort_kinds;
+  const SortKindSet& d_exclude_dt_match_sort_kinds;
+  const SortKindSet& d_exclude_seq_element_sort_kinds;
+  const SortKindSet& d_exclude_set_element_sort_kinds;
 };
 
 /** The action to create a first-order constant. */
@@ -680,7 +680,7 @@ class ActionMkVar : public Action
   void check_variable(RNGenerator& rng, Term term);
 
   /** Unsupported variable sort kinds. */
-  SortKindSet d_unsupported_sorts_kinds;
+  const SortKindSet& d_unsupported_sorts_kinds;
 };
 
 /** The action to create a value. */
@@ -780,7 +780,7 @@ class ActionInstantiateSort : public Action
           cache,
       std::vector<std::pair<std::string, Sort>>& to_trace);
 
-  SortKindSet d_exclude_sort_param_sort_kinds;
+  const SortKindSet& d_exclude_sort_param_sort_kinds;
 };
 
 /** The action to assert a formula. */
@@ -910,7 +910,7 @@ class ActionGetValue : public Action
  private:
   void run(const std::vector<Term>& terms);
 
-  SortKindSet d_exclude_sort_kinds;
+  const SortKindSet& d_exclude_sort_kinds;
 };
 
 /** The action to push one or more context levels. */
@@ -1064,8 +1064,8 @@ class ActionMkFun : public Action
   ActionMkTerm d_mkterm;
   ActionMkVar d_mkvar;
 
-  SortKindSet d_exclude_fun_domain_sort_kinds;
-  SortKindSet d_exclude_fun_codomain_sort_kinds;
+  const SortKindSet& d_exclude_fun_domain_sort_kinds;
+  const SortKindSet& d_exclude_fun_codomain_sort_kinds;
 };
 
 /* -------------------------------------------------------------------------- */
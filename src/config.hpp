@@ -46,6 +46,17 @@
  * of a kind has been exceeded, increase this value.
  */
 #define MURXLA_MAX_KIND_LEN 100
+/**
+ * The size of a cache line in bytes.  Statistics shards of different worker
+ * processes are aligned to this size to avoid false sharing.
+ */
+#define MURXLA_CACHE_LINE_SIZE 64
+/**
+ * The number of buckets of latency histograms.  Bucket i counts latencies in
+ * [2^i, 2^(i+1)) nanoseconds, the last bucket also counts all larger
+ * latencies.
+ */
+#define MURXLA_STATS_N_BUCKETS 36
 
 /** Minimum bit-width for bit-vector terms. */
 #define MURXLA_BW_MIN 1
@@ -121,4 +132,85 @@
 
 #define MURXLA_CHECK_SOLVER_OPT_PREFIX "murxla-check-solver:"
 
+/**
+ * The time limit of a delta debugging test run is this factor times the
+ * runtime of the last successful test run (initially, the golden run).
+ */
+#define MURXLA_DD_TIME_FACTOR 3
+/** The minimum time limit of a delta debugging test run in seconds. */
+#define MURXLA_DD_TIME_MIN 0.1
+/**
+ * The minimum time in seconds between two delta debugging checkpoints written
+ * on successful test runs.  Checkpoints at the beginning of a pass are always
+ * written.
+ */
+#define MURXLA_DD_CHECKPOINT_INTERVAL 10
+/**
+ * The minimum time between two delta debugging checkpoints written on
+ * successful test runs as a factor of the time it took to write the last
+ * checkpoint.  This bounds the time spent on writing checkpoints, which grow
+ * with the number of cached test results.
+ */
+#define MURXLA_DD_CHECKPOINT_OVERHEAD_FACTOR 20
+/**
+ * The number of runs of a delta debugging test when minimizing for a slowdown
+ * (see --dd-slow).  A candidate is only kept if all runs exceed the time
+ * limit, which rejects candidates that are only slow due to noise.
+ */
+#define MURXLA_DD_SLOW_RUNS 3
+
+/**
+ * The time limit in seconds for resetting a pooled online SMT2 solver process
+ * after a test run.  Solvers that do not respond in time are killed.
+ */
+#define MURXLA_SMT2_RESET_TIME 1.0
+
+/**
+ * The maximum size in bytes of a segment file of the SMT2 store (see
+ * --smt2-store).  Benchmarks are appended to a new segment file if the
+ * current segment exceeds this size.
+ */
+#define MURXLA_SMT2_STORE_SEGMENT_SIZE (64 * 1024 * 1024)
+
+/**
+ * The minimum time in seconds a satisfiability check of the solver under test
+ * must take to be compared against other solvers (see --perf-ratio).  Avoids
+ * reporting noise on fast checks.
+ */
+#define MURXLA_PERF_RATIO_MIN_TIME 0.1
+
+/**
+ * The minimum time in seconds between two status snapshots written in
+ * continuous mode (see --stats-file).
+ */
+#define MURXLA_STATS_FILE_INTERVAL 5
+
+/**
+ * The size of the shared memory map of edges covered in the solver under test
+ * (see --cov-feedback), must be a power of 2.
+ */
+#define MURXLA_COV_MAP_SIZE (1 << 16)
+/**
+ * The smoothing factor of the exponential moving average of the coverage
+ * reward of an action or operator (see --cov-feedback).
+ */
+#define MURXLA_COV_ALPHA 0.1
+/**
+ * The bounds of the factor the weight of an action or operator is scaled
+ * with based on its coverage reward (see --cov-feedback).  The lower bound
+ * ensures that rarely rewarded choices are still explored.
+ */
+#define MURXLA_COV_MIN_FACTOR 0.25
+#define MURXLA_COV_MAX_FACTOR 4.0
+/**
+ * The minimum time in seconds between two writes of the learned coverage
+ * weights (see --cov-weights).
+ */
+#define MURXLA_COV_SAVE_INTERVAL 10
+/**
+ * The probability (in per mille) to resume from a prefix of a corpus trace
+ * instead of starting a test run from scratch (see --mutate).
+ */
+#define MURXLA_MUTATE_PROB 500
+
 #endif
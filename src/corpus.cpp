@@ -0,0 +1,186 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "corpus.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "except.hpp"
+#include "rng.hpp"
+#include "util.hpp"
+
+namespace murxla {
+
+namespace {
+
+/** Return true if given trace line is an action (and not its return line). */
+bool
+is_action_line(const std::string& line)
+{
+  if (line.empty() || line[0] == '#') return false;
+  if (line.rfind("set-murxla-options", 0) == 0) return false;
+  return std::get<1>(tokenize(line)) != "return";
+}
+
+/** Read the lines of given trace file. */
+std::vector<std::string>
+read_lines(const std::string& file_name)
+{
+  std::ifstream in = open_input_file(file_name, false);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+Corpus::Corpus(const std::string& dir) : d_dir(dir)
+{
+  std::filesystem::create_directories(d_dir);
+
+  for (const auto& p : std::filesystem::directory_iterator(d_dir))
+  {
+    if (p.path().extension() != ".trace") continue;
+
+    Entry entry;
+    entry.d_file_name = p.path().string();
+    std::ifstream in  = open_input_file(entry.d_file_name, false);
+    std::string line, tag;
+    while (std::getline(in, line) && line.rfind("# ", 0) == 0)
+    {
+      std::stringstream ss(line.substr(2));
+      ss >> tag;
+      if (tag == "seed")
+      {
+        ss >> entry.d_seed;
+      }
+      else if (tag == "features")
+      {
+        std::string feature;
+        while (ss >> feature)
+        {
+          d_features.insert(feature);
+        }
+      }
+    }
+    d_entries.push_back(entry);
+  }
+
+  /* Directory iteration order is unspecified, sort for reproducibility. */
+  std::sort(d_entries.begin(),
+            d_entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.d_file_name < b.d_file_name;
+            });
+}
+
+bool
+Corpus::add(uint64_t seed,
+            const std::string& trace_file_name,
+            const std::vector<std::string>& results,
+            bool new_coverage)
+{
+  std::vector<std::string> lines = read_lines(trace_file_name);
+
+  std::vector<std::string> options;
+  for (const auto& line : lines)
+  {
+    if (!is_action_line(line)) continue;
+    const auto& [s, id, tokens] = tokenize(line);
+    if (id == "set-option" && !tokens.empty())
+    {
+      options.push_back(tokens[0]);
+    }
+  }
+
+  std::unordered_set<std::string> features;
+  for (const auto& result : results)
+  {
+    features.insert(result);
+    for (const auto& option : options)
+    {
+      features.insert(option + ":" + result);
+    }
+  }
+
+  bool new_features = false;
+  for (const auto& feature : features)
+  {
+    new_features |= d_features.insert(feature).second;
+  }
+  if (!new_coverage && !new_features) return false;
+
+  /* Traces with the same canonical form are stored only once. */
+  std::stringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0')
+       << canonical_trace_hash(trace_file_name) << ".trace";
+  std::string file_name = prepend_path(d_dir, name.str());
+  if (std::filesystem::exists(file_name)) return false;
+
+  std::ofstream out = open_output_file(file_name, false);
+  out << "# seed " << seed << "\n";
+  out << "# features";
+  for (const auto& feature : features)
+  {
+    out << " " << feature;
+  }
+  out << "\n";
+  for (const auto& line : lines)
+  {
+    out << line << "\n";
+  }
+  out.close();
+
+  d_entries.push_back({seed, file_name});
+  return true;
+}
+
+const Corpus::Entry&
+Corpus::pick_prefix(RNGenerator& rng, const std::string& file_name)
+{
+  assert(!d_entries.empty());
+  const Entry& entry = d_entries[rng.pick<size_t>(0, d_entries.size() - 1)];
+  std::vector<std::string> lines = read_lines(entry.d_file_name);
+
+  /* Cut before any action but the first one ('new'), the return line of an
+   * action always stays with its action. */
+  std::vector<size_t> cuts;
+  bool first = true;
+  for (size_t i = 0, n = lines.size(); i < n; ++i)
+  {
+    if (!is_action_line(lines[i])) continue;
+    if (!first) cuts.push_back(i);
+    first = false;
+  }
+  size_t cut = cuts.empty() ? lines.size()
+                            : rng.pick_from_set<decltype(cuts), size_t>(cuts);
+
+  std::ofstream out = open_output_file(file_name, false);
+  for (size_t i = 0; i < cut; ++i)
+  {
+    out << lines[i] << "\n";
+  }
+  out.close();
+  return entry;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
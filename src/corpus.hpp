@@ -0,0 +1,104 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__CORPUS_H
+#define __MURXLA__CORPUS_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace murxla {
+
+class RNGenerator;
+
+/**
+ * A corpus of API traces of interesting test runs.
+ *
+ * A test run is interesting if it covered new solver code (see
+ * coverage::Feedback) or if it produced a new feature.  The features of a run
+ * are the check-sat results it produced, and each combination of an option
+ * set in the run with a check-sat result.
+ *
+ * Corpus traces serve as prefixes for mutated test runs, which replay a
+ * corpus trace up to a random cut point and continue with random generation
+ * from there (see FSM::resume()).  The seed of the original run is stored
+ * with the trace, the FSM of a mutated run is configured with this seed to
+ * enable the same theories as the original run.
+ *
+ * The corpus directory contains one file '<hash>.trace' per trace, named
+ * after the hash of its canonical form (see canonical_trace_hash()).  The
+ * seed and features are stored in comment lines at the beginning of the
+ * trace:
+ *
+ *   # seed <seed>
+ *   # features <feature> ...
+ *
+ * A corpus may be reused over multiple runs, but not concurrently.
+ */
+class Corpus
+{
+ public:
+  /** A trace of the corpus. */
+  struct Entry
+  {
+    /** The seed of the test run that produced the trace. */
+    uint64_t d_seed = 0;
+    /** The path of the trace file. */
+    std::string d_file_name;
+  };
+
+  /**
+   * Constructor.
+   * Creates the corpus directory if it does not exist yet, else loads the
+   * existing traces.
+   * dir: The directory of the corpus.
+   */
+  Corpus(const std::string& dir);
+
+  /**
+   * Add the trace of a test run if the run was interesting.
+   * seed           : The seed the FSM of the test run was configured with.
+   * trace_file_name: The API trace of the test run.
+   * results        : The check-sat results of the test run.
+   * new_coverage   : True if the test run covered new solver code.
+   * Returns true if the trace was added.
+   */
+  bool add(uint64_t seed,
+           const std::string& trace_file_name,
+           const std::vector<std::string>& results,
+           bool new_coverage);
+
+  /** Return true if the corpus contains no traces. */
+  bool empty() const { return d_entries.empty(); }
+  /** Get the number of traces in the corpus. */
+  size_t size() const { return d_entries.size(); }
+
+  /**
+   * Pick a corpus trace and write a prefix of it, up to a random action, to
+   * given file.
+   * rng      : The random number generator.
+   * file_name: The file to write the trace prefix to.
+   * Returns the picked trace.
+   */
+  const Entry& pick_prefix(RNGenerator& rng, const std::string& file_name);
+
+ private:
+  /** The directory of the corpus. */
+  std::string d_dir;
+  /** The traces of the corpus. */
+  std::vector<Entry> d_entries;
+  /** The features produced by the traces of the corpus. */
+  std::unordered_set<std::string> d_features;
+};
+
+}  // namespace murxla
+
+#endif
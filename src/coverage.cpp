@@ -0,0 +1,275 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "coverage.hpp"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <nlohmann/json.hpp>
+
+#include "config.hpp"
+#include "except.hpp"
+#include "statistics.hpp"
+#include "util.hpp"
+
+/* -------------------------------------------------------------------------- */
+/* SanitizerCoverage callbacks                                                */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+/**
+ * The map of covered edges, allocated in shared memory on initialization of
+ * the first instrumented module.  Test run processes inherit the map, and
+ * covered edges are thus visible to the parent process.
+ */
+uint8_t* s_cov_map = nullptr;
+/** The number of instrumented edges. */
+uint32_t s_cov_num_guards = 0;
+}  // namespace
+
+extern "C" {
+
+void
+__sanitizer_cov_trace_pc_guard_init(uint32_t* start, uint32_t* stop)
+{
+  if (start == stop || *start) return;
+  if (s_cov_map == nullptr)
+  {
+    void* mem = mmap(nullptr,
+                     MURXLA_COV_MAP_SIZE,
+                     PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS,
+                     -1,
+                     0);
+    /* Leave guards disabled (0) if no map can be allocated. */
+    if (mem == MAP_FAILED) return;
+    s_cov_map = static_cast<uint8_t*>(mem);
+  }
+  for (uint32_t* guard = start; guard < stop; ++guard)
+  {
+    *guard = ++s_cov_num_guards;
+  }
+}
+
+void
+__sanitizer_cov_trace_pc_guard(uint32_t* guard)
+{
+  if (*guard == 0) return;
+  s_cov_map[*guard & (MURXLA_COV_MAP_SIZE - 1)] = 1;
+}
+}
+
+namespace murxla {
+namespace coverage {
+
+/* -------------------------------------------------------------------------- */
+
+bool
+is_available()
+{
+  return s_cov_map != nullptr;
+}
+
+void
+reset()
+{
+  if (s_cov_map) memset(s_cov_map, 0, MURXLA_COV_MAP_SIZE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/** Avoids division by zero when computing weights of unrewarded arms. */
+constexpr double COV_EPSILON = 1e-3;
+
+/** Get the kinds in given statistics name table, up to the first empty one. */
+template <size_t N>
+std::vector<std::string>
+get_names(const char (&names)[N][MURXLA_MAX_KIND_LEN])
+{
+  std::vector<std::string> res;
+  for (size_t i = 0; i < N && names[i][0]; ++i)
+  {
+    res.emplace_back(names[i]);
+  }
+  return res;
+}
+
+}  // namespace
+
+Feedback::Feedback(statistics::Statistics* stats)
+    : d_stats(stats),
+      d_covered(MURXLA_COV_MAP_SIZE, 0),
+      d_action_totals(MURXLA_MAX_N_ACTIONS, 0),
+      d_op_totals(MURXLA_MAX_N_OPS, 0),
+      d_action_counts(MURXLA_MAX_N_ACTIONS, 0),
+      d_op_counts(MURXLA_MAX_N_OPS, 0)
+{
+}
+
+uint64_t
+Feedback::collect()
+{
+  assert(s_cov_map);
+
+  /* Merge the edges covered by the last run, skip unused parts of the map
+   * word by word. */
+  uint64_t num_new = 0;
+  const uint64_t* words = reinterpret_cast<const uint64_t*>(s_cov_map);
+  for (size_t i = 0; i < MURXLA_COV_MAP_SIZE / sizeof(uint64_t); ++i)
+  {
+    if (words[i] == 0) continue;
+    for (size_t j = i * sizeof(uint64_t); j < (i + 1) * sizeof(uint64_t); ++j)
+    {
+      if (s_cov_map[j] && !d_covered[j])
+      {
+        d_covered[j] = 1;
+        num_new += 1;
+      }
+    }
+  }
+  d_num_edges += num_new;
+  /* Diminishing reward for large coverage gains. */
+  d_reward = std::log2(1.0 + static_cast<double>(num_new));
+
+  /* The statistics are only recorded by the main test runs, the difference
+   * to the previous run yields the counts of the last run. */
+  for (size_t i = 0; i < MURXLA_MAX_N_ACTIONS; ++i)
+  {
+    uint64_t n         = d_stats->get_num_actions(i);
+    d_action_counts[i] = n - d_action_totals[i];
+    d_action_totals[i] = n;
+  }
+  for (size_t i = 0; i < MURXLA_MAX_N_OPS; ++i)
+  {
+    uint64_t n     = d_stats->get_num_ops(i);
+    d_op_counts[i] = n - d_op_totals[i];
+    d_op_totals[i] = n;
+  }
+  return num_new;
+}
+
+void
+Feedback::update()
+{
+  update(d_action_arms,
+         get_names(d_stats->d_action_kinds),
+         d_action_counts,
+         d_action_weights);
+  update(d_op_arms, get_names(d_stats->d_op_kinds), d_op_counts, d_op_weights);
+}
+
+void
+Feedback::update(ArmMap& arms,
+                 const std::vector<std::string>& names,
+                 const std::vector<uint64_t>& counts,
+                 std::vector<double>& weights)
+{
+  for (size_t i = 0, n = names.size(); i < n; ++i)
+  {
+    if (counts[i] == 0) continue;
+    Arm& arm = arms[names[i]];
+    if (arm.d_runs == 0)
+    {
+      arm.d_reward = d_reward;
+    }
+    else
+    {
+      arm.d_reward += MURXLA_COV_ALPHA * (d_reward - arm.d_reward);
+    }
+    arm.d_runs += 1;
+  }
+
+  double sum = 0;
+  for (const auto& [name, arm] : arms)
+  {
+    sum += arm.d_reward;
+  }
+  double mean = arms.empty() ? 0 : sum / static_cast<double>(arms.size());
+
+  /* Arms that were never used keep their static weight. */
+  weights.assign(names.size(), 1.0);
+  for (size_t i = 0, n = names.size(); i < n; ++i)
+  {
+    auto it = arms.find(names[i]);
+    if (it == arms.end()) continue;
+    weights[i] = std::clamp((it->second.d_reward + COV_EPSILON)
+                                / (mean + COV_EPSILON),
+                            MURXLA_COV_MIN_FACTOR,
+                            MURXLA_COV_MAX_FACTOR);
+  }
+}
+
+void
+Feedback::load(const std::string& file_name)
+{
+  if (!std::filesystem::exists(file_name)) return;
+
+  std::ifstream in_file = open_input_file(file_name, false);
+  nlohmann::json j;
+  try
+  {
+    in_file >> j;
+    for (const auto& [key, arms] :
+         {std::make_pair("actions", &d_action_arms),
+          std::make_pair("ops", &d_op_arms)})
+    {
+      for (const auto& item : j.at(key).items())
+      {
+        (*arms)[item.key()] = {item.value().at("reward").get<double>(),
+                               item.value().at("runs").get<uint64_t>()};
+      }
+    }
+  }
+  catch (nlohmann::json::exception& e)
+  {
+    MURXLA_EXIT_ERROR(true) << "invalid coverage weights file '" << file_name
+                            << "': " << e.what();
+  }
+
+  /* Compute the weights of the loaded arms, no new reward. */
+  std::fill(d_action_counts.begin(), d_action_counts.end(), 0);
+  std::fill(d_op_counts.begin(), d_op_counts.end(), 0);
+  update();
+}
+
+void
+Feedback::save(const std::string& file_name) const
+{
+  nlohmann::json j;
+  for (const auto& [key, arms] : {std::make_pair("actions", &d_action_arms),
+                                  std::make_pair("ops", &d_op_arms)})
+  {
+    j[key] = nlohmann::json::object();
+    for (const auto& [name, arm] : *arms)
+    {
+      j[key][name] = {{"reward", arm.d_reward}, {"runs", arm.d_runs}};
+    }
+  }
+
+  /* Write to temp file first, the weights are replaced atomically. */
+  std::string tmp_file_name = file_name + ".tmp";
+  std::ofstream out_file    = open_output_file(tmp_file_name, false);
+  out_file << std::setw(2) << j << std::endl;
+  out_file.close();
+  std::filesystem::rename(tmp_file_name, file_name);
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace coverage
+}  // namespace murxla
@@ -0,0 +1,157 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__COVERAGE_H
+#define __MURXLA__COVERAGE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace murxla {
+
+namespace statistics {
+struct Statistics;
+}
+
+namespace coverage {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Return true if the solver under test was built with
+ * -fsanitize-coverage=trace-pc-guard.
+ *
+ * Murxla implements the SanitizerCoverage callbacks and records the covered
+ * edges of instrumented code in a map in shared memory, which is inherited by
+ * the test run processes.
+ */
+bool is_available();
+
+/** Clear the map of covered edges, e.g., before a test run. */
+void reset();
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Coverage-guided weighting of actions and operators.
+ *
+ * After each test run, the edges covered by the run are compared against the
+ * edges covered by all previous runs.  The number of newly covered edges is
+ * the reward of the run.  Every action and operator used in a run is treated
+ * as an arm of a multi-armed bandit and maintains an exponential moving
+ * average of the rewards of the runs it was used in.  The weight of an arm
+ * is its average reward relative to the mean over all arms, bounded by
+ * MURXLA_COV_MIN_FACTOR and MURXLA_COV_MAX_FACTOR.  Weights thus drift
+ * towards choices that correlate with new coverage, and back to 1 as the
+ * coverage saturates.
+ *
+ * Arms are identified by the action and operator kinds (rather than their
+ * ids) to allow persisting the learned weights over multiple sessions.
+ */
+class Feedback
+{
+ public:
+  /**
+   * Constructor.
+   * stats: The statistics the action and operator counts of a test run are
+   *        derived from.
+   */
+  Feedback(statistics::Statistics* stats);
+
+  /**
+   * Collect the covered edges and the action and operator counts of the last
+   * test run.  Must be called right after the test run, and followed by a
+   * call to update().
+   *
+   * Returns the number of newly covered edges.
+   */
+  uint64_t collect();
+
+  /** Update the weights based on the last collected test run. */
+  void update();
+
+  /**
+   * Get the weight factors of the actions, indexed by action id.  Empty if no
+   * weights were learned yet.
+   */
+  const std::vector<double>& get_action_weights() const
+  {
+    return d_action_weights;
+  }
+  /**
+   * Get the weight factors of the operators, indexed by operator id.  Empty if
+   * no weights were learned yet.
+   */
+  const std::vector<double>& get_op_weights() const { return d_op_weights; }
+
+  /** Get the number of edges covered so far. */
+  uint64_t get_num_edges() const { return d_num_edges; }
+
+  /** Load learned weights from given file. */
+  void load(const std::string& file_name);
+  /** Write learned weights to given file. The file is replaced atomically. */
+  void save(const std::string& file_name) const;
+
+ private:
+  /** An action or operator. */
+  struct Arm
+  {
+    /** The exponential moving average of the rewards. */
+    double d_reward = 0;
+    /** The number of runs this arm was used in. */
+    uint64_t d_runs = 0;
+  };
+  using ArmMap = std::unordered_map<std::string, Arm>;
+
+  /**
+   * Update the given arms with the reward of the last run and compute the
+   * weight factors.
+   *
+   * arms   : The arms to update.
+   * names  : The kinds of the arms, indexed by id.
+   * counts : The number of uses of each arm in the last run, indexed by id.
+   * weights: The resulting weight factors, indexed by id.
+   */
+  void update(ArmMap& arms,
+              const std::vector<std::string>& names,
+              const std::vector<uint64_t>& counts,
+              std::vector<double>& weights);
+
+  /** The associated statistics. */
+  statistics::Statistics* d_stats;
+  /** The edges covered by all runs so far. */
+  std::vector<uint8_t> d_covered;
+  /** The number of edges covered by all runs so far. */
+  uint64_t d_num_edges = 0;
+  /** The reward of the last collected run. */
+  double d_reward = 0;
+
+  /** The action and operator counts of the statistics after the last run. */
+  std::vector<uint64_t> d_action_totals;
+  std::vector<uint64_t> d_op_totals;
+  /** The action and operator counts of the last run. */
+  std::vector<uint64_t> d_action_counts;
+  std::vector<uint64_t> d_op_counts;
+
+  /** The action and operator arms. */
+  ArmMap d_action_arms;
+  ArmMap d_op_arms;
+  /** The weight factors of the actions and operators, indexed by id. */
+  std::vector<double> d_action_weights;
+  std::vector<double> d_op_weights;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace coverage
+}  // namespace murxla
+
+#endif
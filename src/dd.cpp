@@ -12,7 +12,9 @@
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <nlohmann/json.hpp>
 
+#include "config.hpp"
 #include "except.hpp"
 #include "murxla.hpp"
 #include "solver_manager.hpp"
@@ -71,6 +73,104 @@ split_superset(const std::vector<size_t> superset, size_t subset_size)
   assert(subsets.size() == (size_t) superset_size / subset_size);
   return subsets;
 }
+
+/**
+ * Return true if the given trace token is a sort or term id (e.g., 's1' or
+ * 't42').
+ */
+bool
+is_trace_id(const std::string& token)
+{
+  return token.size() > 1 && (token[0] == 's' || token[0] == 't')
+         && token.find_first_not_of("0123456789", 1) == std::string::npos;
+}
+
+/**
+ * Build the def-use graph of sort and term ids of a trace.
+ *
+ * A line defines the ids in its return statement that are not defined by any
+ * previous line. Return statements may refer to already defined ids, e.g.,
+ * the sort of a term created via 'mk-term'.  A line uses all ids that occur
+ * as arguments of its action line.
+ *
+ * lines         : The set of trace lines representing the full (unminimized)
+ *                 trace.  A line is represented as a vector of strings with at
+ *                 most 2 elements.
+ * included_lines: The current set of considered lines.
+ *
+ * return: A map from line index to the indices of the lines defining the ids
+ *         used by that line.
+ */
+std::unordered_map<size_t, std::vector<size_t>>
+build_dependency_graph(const std::vector<std::vector<std::string>>& lines,
+                       const std::vector<size_t>& included_lines)
+{
+  std::unordered_map<size_t, std::vector<size_t>> deps;
+  std::unordered_map<std::string, size_t> defs;
+
+  auto add_use = [&defs, &deps](size_t line_idx, const std::string& id) {
+    auto it = defs.find(id);
+    if (it != defs.end() && it->second != line_idx)
+    {
+      auto& d = deps[line_idx];
+      if (std::find(d.begin(), d.end(), it->second) == d.end())
+      {
+        d.push_back(it->second);
+      }
+    }
+  };
+
+  for (size_t line_idx : included_lines)
+  {
+    const auto& [seed, action_kind, tokens] = tokenize(lines[line_idx][0]);
+    for (const auto& token : tokens)
+    {
+      if (is_trace_id(token)) add_use(line_idx, token);
+    }
+    if (lines[line_idx].size() == 2)
+    {
+      const auto& [seed_return, action_kind_return, tokens_return] =
+          tokenize(lines[line_idx][1]);
+      for (const auto& token : tokens_return)
+      {
+        if (!is_trace_id(token)) continue;
+        if (defs.find(token) == defs.end())
+        {
+          defs.emplace(token, line_idx);
+        }
+        else
+        {
+          add_use(line_idx, token);
+        }
+      }
+    }
+  }
+  return deps;
+}
+
+/**
+ * Return true if the given set of lines is closed under dependencies, i.e.,
+ * if all ids used by the lines in 'superset' are defined by lines in
+ * 'superset'.  Test runs on traces that are not closed under dependencies
+ * always fail with an untrace error.
+ */
+bool
+is_dependency_closed(
+    const std::unordered_map<size_t, std::vector<size_t>>& deps,
+    const std::vector<size_t>& superset)
+{
+  std::unordered_set<size_t> lines(superset.begin(), superset.end());
+  for (size_t line_idx : superset)
+  {
+    auto it = deps.find(line_idx);
+    if (it == deps.end()) continue;
+    for (size_t dep : it->second)
+    {
+      if (lines.find(dep) == lines.end()) return false;
+    }
+  }
+  return true;
+}
 }  // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -83,8 +183,12 @@ DD::DD(Murxla* murxla, uint64_t seed)
       get_tmp_file_path("tmp-dd-gold.out", d_murxla->d_tmp_dir);
   d_gold_err_file_name =
       get_tmp_file_path("tmp-dd-gold.err", d_murxla->d_tmp_dir);
-  d_tmp_trace_file_name =
-      get_tmp_file_path("tmp-api-dd.trace", d_murxla->d_tmp_dir);
+}
+
+void
+DD::set_test_function(TestFunction test)
+{
+  d_test = test;
 }
 
 void
@@ -115,25 +219,42 @@ DD::run(const std::string& input_trace_file_name,
                             false,
                             Murxla::TraceMode::TO_FILE);
   auto end   = std::chrono::system_clock::now();
-  // Compute time limit for delta-debugging tests (3 * golden runtime).
+  // Compute initial time limit for delta-debugging tests.
   auto gold_time = std::chrono::duration<double>(end - start).count();
-  d_time         = gold_time * 3;
+  d_time = std::max(MURXLA_DD_TIME_MIN, gold_time * MURXLA_DD_TIME_FACTOR);
 
   MURXLA_EXIT_ERROR(gold_exit == RESULT_ERROR_UNTRACE) << d_murxla->d_error_msg;
+  d_gold_exit = gold_exit;
+
+  if (d_murxla->d_options.dd_slow > 0)
+  {
+    MURXLA_EXIT_ERROR(gold_time < d_murxla->d_options.dd_slow)
+        << "golden run takes " << std::fixed << std::setprecision(2)
+        << gold_time << "s, which does not exceed the time limit of "
+        << d_murxla->d_options.dd_slow << "s given via --dd-slow";
+    /* Test runs only need to run until they exceed the time limit. */
+    d_time = d_murxla->d_options.dd_slow;
+  }
 
   MURXLA_MESSAGE_DD << "golden exit: " << gold_exit;
   {
     std::ifstream gold_out_file = open_input_file(d_gold_out_file_name, false);
     std::stringstream ss;
     ss << gold_out_file.rdbuf();
-    MURXLA_MESSAGE_DD << "golden stdout output: " << ss.str();
+    d_gold_out = ss.str();
+    MURXLA_MESSAGE_DD << "golden stdout output: " << d_gold_out;
     gold_out_file.close();
   }
   {
     std::ifstream gold_err_file = open_input_file(d_gold_err_file_name, false);
-    MURXLA_MESSAGE_DD << "golden stderr output: " << gold_err_file.rdbuf();
+    std::stringstream ss;
+    ss << gold_err_file.rdbuf();
+    d_gold_err = ss.str();
+    MURXLA_MESSAGE_DD << "golden stderr output: " << d_gold_err;
     gold_err_file.close();
   }
+  d_gold_out_hash = std::hash<std::string>{}(d_gold_out);
+  d_gold_err_hash = std::hash<std::string>{}(d_gold_err);
   if (d_murxla->d_options.dd_ignore_out)
   {
     MURXLA_MESSAGE_DD << "ignoring stdout output";
@@ -156,6 +277,16 @@ DD::run(const std::string& input_trace_file_name,
                       << d_murxla->d_options.dd_match_err.c_str()
                       << "' in stderr output";
   }
+  if (d_murxla->d_options.dd_slow > 0)
+  {
+    MURXLA_MESSAGE_DD << "golden runtime: " << std::fixed
+                      << std::setprecision(2) << gold_time << "s";
+    MURXLA_MESSAGE_DD << "keeping traces that take more than "
+                      << d_murxla->d_options.dd_slow << "s in "
+                      << MURXLA_DD_SLOW_RUNS << " runs";
+  }
+  MURXLA_MESSAGE_DD << "initial time limit for test runs: " << std::fixed
+                    << std::setprecision(2) << d_time << "s";
 
   /* Start delta debugging */
 
@@ -198,53 +329,82 @@ DD::run(const std::string& input_trace_file_name,
   }
   trace_file.close();
 
-  uint64_t iterations = 0;
   std::uintmax_t size = std::filesystem::file_size(tmp_input_trace_file_name);
   std::vector<size_t> included_lines(lines.size());
   std::iota(included_lines.begin(), included_lines.end(), 0);
-  bool success, fixed_point;
+  bool success;
+
+  assert(!reduced_trace_file_name.empty());
+  if (!d_murxla->d_options.out_dir.empty())
+  {
+    reduced_trace_file_name =
+        prepend_path(d_murxla->d_options.out_dir, reduced_trace_file_name);
+  }
+  d_checkpoint_file_name = reduced_trace_file_name + ".checkpoint";
+  {
+    std::ifstream in_file = open_input_file(input_trace_file_name, false);
+    std::stringstream ss;
+    ss << in_file.rdbuf();
+    d_input_hash = fnv1a_hash(ss.str());
+  }
+
+  if (d_murxla->d_options.dd_resume)
+  {
+    load_checkpoint(lines, included_lines);
+  }
 
   do
   {
-    fixed_point = true;
+    success = false;
 
-    success = minimize_lines(
-        gold_exit, lines, included_lines, tmp_input_trace_file_name);
+    if (d_pass <= PASS_MINIMIZE_LINES_DEPS)
+    {
+      start_pass(PASS_MINIMIZE_LINES_DEPS, lines, included_lines);
+      success = minimize_lines_dependencies(gold_exit, lines, included_lines);
+    }
 
-    if (!success && iterations > 0) break;
+    if (d_pass <= PASS_MINIMIZE_LINES)
+    {
+      start_pass(PASS_MINIMIZE_LINES, lines, included_lines);
+      success = minimize_lines(gold_exit, lines, included_lines) || success;
+      if (!success && d_iteration > 0) break;
+    }
 
-    if (minimize_line(
-            gold_exit, lines, included_lines, tmp_input_trace_file_name))
+    if (d_pass <= PASS_MINIMIZE_LINE)
     {
-      fixed_point = false;
+      start_pass(PASS_MINIMIZE_LINE, lines, included_lines);
+      if (minimize_line(gold_exit, lines, included_lines))
+      {
+        d_fixed_point = false;
+      }
     }
 
-    if (substitute_terms(
-            gold_exit, lines, included_lines, tmp_input_trace_file_name))
+    if (d_pass <= PASS_SUBSTITUTE_TERMS)
     {
-      fixed_point = false;
+      start_pass(PASS_SUBSTITUTE_TERMS, lines, included_lines);
+      if (substitute_terms(gold_exit, lines, included_lines))
+      {
+        d_fixed_point = false;
+      }
     }
 
-    iterations += 1;
-  } while (!fixed_point);
+    d_iteration += 1;
+    d_pass = PASS_MINIMIZE_LINES_DEPS;
+    if (d_fixed_point) break;
+    d_fixed_point = true;
+  } while (true);
 
-  /* Write minimized trace file to path if given. */
-  assert(!reduced_trace_file_name.empty());
-  if (!d_murxla->d_options.out_dir.empty())
-  {
-    reduced_trace_file_name =
-        prepend_path(d_murxla->d_options.out_dir, reduced_trace_file_name);
-  }
+  d_murxla->stop_snapshot();
 
   MURXLA_MESSAGE_DD;
   MURXLA_MESSAGE_DD << d_ntests_success << " (of " << d_ntests
                     << ") tests reduced successfully";
 
-  if (std::filesystem::exists(d_tmp_trace_file_name))
+  /* Candidate traces are only kept in memory, the reduced trace is the only
+   * trace that is written to disk. */
+  if (d_ntests_success > 0)
   {
-    std::filesystem::copy(d_tmp_trace_file_name,
-                          reduced_trace_file_name,
-                          std::filesystem::copy_options::overwrite_existing);
+    write_lines_to_file(lines, included_lines, reduced_trace_file_name);
 
     MURXLA_MESSAGE_DD << "written to: " << reduced_trace_file_name.c_str();
     MURXLA_MESSAGE_DD << "file reduced to "
@@ -257,19 +417,138 @@ DD::run(const std::string& input_trace_file_name,
   {
     MURXLA_MESSAGE_DD << "unable to reduce api trace";
   }
+
+  /* Delta debugging finished, the checkpoint is not needed anymore. */
+  std::filesystem::remove(d_checkpoint_file_name);
+}
+
+void
+DD::start_pass(Pass pass,
+               const std::vector<std::vector<std::string>>& lines,
+               const std::vector<size_t>& included_lines)
+{
+  d_pass = pass;
+  save_checkpoint(lines, included_lines, true);
+}
+
+void
+DD::save_checkpoint(const std::vector<std::vector<std::string>>& lines,
+                    const std::vector<size_t>& included_lines,
+                    bool force)
+{
+  /* No checkpoint file if passes are not run via run(). */
+  if (d_checkpoint_file_name.empty()) return;
+
+  auto now = std::chrono::steady_clock::now();
+  if (!force
+      && std::chrono::duration<double>(now - d_checkpoint_time).count()
+             < std::max<double>(
+                 MURXLA_DD_CHECKPOINT_INTERVAL,
+                 d_checkpoint_write_time
+                     * MURXLA_DD_CHECKPOINT_OVERHEAD_FACTOR))
+  {
+    return;
+  }
+  d_checkpoint_time = now;
+
+  nlohmann::json j;
+  j["lines"]          = lines;
+  j["included_lines"] = included_lines;
+  j["pass"]           = d_pass;
+  j["iteration"]      = d_iteration;
+  j["fixed_point"]    = d_fixed_point;
+  j["ntests"]         = d_ntests;
+  j["ntests_success"] = d_ntests_success;
+  j["input_hash"]     = d_input_hash;
+  j["gold_exit"]      = d_gold_exit;
+  j["gold_out_hash"]  = fnv1a_hash(d_gold_out);
+  j["gold_err_hash"]  = fnv1a_hash(d_gold_err);
+  /* Cached results for other trace lines are not valid after resuming. */
+  j["memo"] = d_memo_lines == lines ? d_memo : decltype(d_memo)();
+
+  /* Write to temp file first, the checkpoint is replaced atomically. */
+  std::string tmp_file_name = d_checkpoint_file_name + ".tmp";
+  std::ofstream out_file    = open_output_file(tmp_file_name, false);
+  out_file << j;
+  out_file.close();
+  std::filesystem::rename(tmp_file_name, d_checkpoint_file_name);
+  d_checkpoint_write_time = std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - now)
+                                .count();
+}
+
+void
+DD::load_checkpoint(std::vector<std::vector<std::string>>& lines,
+                    std::vector<size_t>& included_lines)
+{
+  if (!std::filesystem::exists(d_checkpoint_file_name))
+  {
+    MURXLA_MESSAGE_DD << "no checkpoint '" << d_checkpoint_file_name
+                      << "' found, starting from scratch";
+    return;
+  }
+
+  nlohmann::json j;
+  try
+  {
+    std::ifstream in_file = open_input_file(d_checkpoint_file_name, false);
+    j                     = nlohmann::json::parse(in_file);
+    in_file.close();
+  }
+  catch (const nlohmann::detail::exception& e)
+  {
+    MURXLA_EXIT_ERROR(true) << "invalid checkpoint '" << d_checkpoint_file_name
+                            << "': " << e.what();
+  }
+
+  /* The trace lines, cached test results and pass state of the checkpoint
+   * are only valid for the same input trace and golden run.  The golden
+   * outputs only matter if test runs compare against them. */
+  const Options& options = d_murxla->d_options;
+  bool check_out = !options.dd_ignore_out && options.dd_match_out.empty();
+  bool check_err = !options.dd_ignore_err && options.dd_match_err.empty();
+  if (!j.contains("input_hash")
+      || j.at("input_hash").get<uint64_t>() != d_input_hash
+      || j.at("gold_exit").get<Result>() != d_gold_exit
+      || (check_out
+          && j.at("gold_out_hash").get<uint64_t>() != fnv1a_hash(d_gold_out))
+      || (check_err
+          && j.at("gold_err_hash").get<uint64_t>() != fnv1a_hash(d_gold_err)))
+  {
+    MURXLA_MESSAGE_DD << "checkpoint '" << d_checkpoint_file_name
+                      << "' does not match the given trace or its golden "
+                         "run, starting from scratch";
+    return;
+  }
+
+  lines          = j.at("lines").get<std::vector<std::vector<std::string>>>();
+  included_lines = j.at("included_lines").get<std::vector<size_t>>();
+  d_pass         = j.at("pass").get<Pass>();
+  d_iteration    = j.at("iteration").get<uint64_t>();
+  d_fixed_point  = j.at("fixed_point").get<bool>();
+  d_ntests       = j.at("ntests").get<uint64_t>();
+  d_ntests_success = j.at("ntests_success").get<uint64_t>();
+  d_memo           = j.at("memo").get<decltype(d_memo)>();
+  d_memo_lines     = lines;
+
+  MURXLA_MESSAGE_DD << "resuming from checkpoint '" << d_checkpoint_file_name
+                    << "' (iteration " << d_iteration << ", pass " << d_pass
+                    << ", " << included_lines.size() << " lines)";
 }
 
 bool
 DD::minimize_lines(Result golden_exit,
                    const std::vector<std::vector<std::string>>& lines,
-                   std::vector<size_t>& included_lines,
-                   const std::string& input_trace_file_name)
+                   std::vector<size_t>& included_lines)
 {
   MURXLA_MESSAGE_DD << "trying to minimize number of trace lines ...";
   size_t n_lines     = included_lines.size();
   size_t n_lines_cur = n_lines;
   size_t subset_size = n_lines_cur / 2;
 
+  /* Lines are not modified here, the graph stays valid while removing. */
+  auto deps = build_dependency_graph(lines, included_lines);
+
   while (subset_size > 0)
   {
     std::vector<std::vector<size_t>> subsets =
@@ -286,10 +565,11 @@ DD::minimize_lines(Result golden_exit,
       std::unordered_set<size_t> ex(excluded_sets);
       ex.insert(idx);
 
-      std::vector<size_t> tmp_superset = test(golden_exit,
-                                              lines,
-                                              remove_subsets(subsets, ex),
-                                              input_trace_file_name);
+      /* skip candidates that remove definitions of ids still in use */
+      std::vector<size_t> candidate = remove_subsets(subsets, ex);
+      if (!is_dependency_closed(deps, candidate)) continue;
+
+      std::vector<size_t> tmp_superset = test(golden_exit, lines, candidate);
       if (!tmp_superset.empty())
       {
         superset_cur = tmp_superset;
@@ -302,8 +582,6 @@ DD::minimize_lines(Result golden_exit,
     }
     else
     {
-      /* write found subset immediately to file and continue */
-      write_lines_to_file(lines, superset_cur, d_tmp_trace_file_name);
       included_lines = superset_cur;
       n_lines_cur    = included_lines.size();
       subset_size    = n_lines_cur / 2;
@@ -317,6 +595,111 @@ DD::minimize_lines(Result golden_exit,
   return included_lines.size() < n_lines;
 }
 
+bool
+DD::minimize_lines_dependencies(
+    Result golden_exit,
+    const std::vector<std::vector<std::string>>& lines,
+    std::vector<size_t>& included_lines)
+{
+  MURXLA_MESSAGE_DD << "trying to minimize number of trace lines by removing "
+                       "definitions with all their uses ...";
+  size_t n_lines = included_lines.size();
+  if (n_lines < 2) return false;
+
+  /* Map line index to the indices of the lines that use ids it defines. */
+  std::unordered_map<size_t, std::vector<size_t>> users;
+  for (const auto& [line_idx, deps] :
+       build_dependency_graph(lines, included_lines))
+  {
+    for (size_t dep : deps)
+    {
+      users[dep].push_back(line_idx);
+    }
+  }
+
+  /* We never remove the first line (it contains 'new'). */
+  size_t first       = included_lines[0];
+  size_t subset_size = n_lines / 2;
+
+  while (subset_size > 0)
+  {
+    std::vector<std::vector<size_t>> subsets =
+        split_superset(included_lines, subset_size);
+    std::unordered_set<size_t> cur(included_lines.begin(),
+                                   included_lines.end());
+    bool reduced = false;
+
+    /* remove subsets from last to first */
+    for (size_t i = subsets.size(); i > 0; --i)
+    {
+      /* Compute the set of lines to remove: the lines in the subset and all
+       * the lines that transitively depend on them. */
+      std::unordered_set<size_t> to_remove;
+      std::vector<size_t> visit;
+      for (size_t line_idx : subsets[i - 1])
+      {
+        if (line_idx != first && cur.find(line_idx) != cur.end())
+        {
+          visit.push_back(line_idx);
+        }
+      }
+      while (!visit.empty())
+      {
+        size_t line_idx = visit.back();
+        visit.pop_back();
+        if (!to_remove.insert(line_idx).second) continue;
+        auto it = users.find(line_idx);
+        if (it == users.end()) continue;
+        for (size_t user : it->second)
+        {
+          if (cur.find(user) != cur.end()) visit.push_back(user);
+        }
+      }
+      if (to_remove.empty()) continue;
+
+      std::vector<size_t> candidate;
+      for (size_t line_idx : included_lines)
+      {
+        if (cur.find(line_idx) != cur.end()
+            && to_remove.find(line_idx) == to_remove.end())
+        {
+          candidate.push_back(line_idx);
+        }
+      }
+
+      if (!test(golden_exit, lines, candidate).empty())
+      {
+        for (size_t line_idx : to_remove)
+        {
+          cur.erase(line_idx);
+        }
+        reduced = true;
+      }
+    }
+
+    if (!reduced)
+    {
+      subset_size = subset_size / 2;
+    }
+    else
+    {
+      std::vector<size_t> superset_cur;
+      for (size_t line_idx : included_lines)
+      {
+        if (cur.find(line_idx) != cur.end()) superset_cur.push_back(line_idx);
+      }
+      included_lines = superset_cur;
+      subset_size    = included_lines.size() / 2;
+      MURXLA_MESSAGE_DD << ">> number of lines reduced to " << std::fixed
+                        << std::setprecision(2)
+                        << (static_cast<double>(included_lines.size())
+                            / static_cast<double>(n_lines) * 100)
+                        << "% of original number";
+    }
+  }
+  return included_lines.size() < n_lines;
+}
+
 namespace {
 
 /**
@@ -653,8 +1036,7 @@ collect_terms_by_sort(
 bool
 DD::substitute_terms(Result golden_exit,
                      std::vector<std::vector<std::string>>& lines,
-                     std::vector<size_t>& included_lines,
-                     const std::string& input_trace_file_name)
+                     std::vector<size_t>& included_lines)
 {
   MURXLA_MESSAGE_DD << "trying to minimize trace by substituting terms ...";
 
@@ -712,7 +1094,7 @@ DD::substitute_terms(Result golden_exit,
             }
 
             std::vector<size_t> tmp_superset =
-                test(golden_exit, lines, included_lines, input_trace_file_name);
+                test(golden_exit, lines, included_lines);
 
             if (!tmp_superset.empty())
             {
@@ -736,8 +1118,6 @@ DD::substitute_terms(Result golden_exit,
           }
           else
           {
-            /* write found subset immediately to file and continue */
-            write_lines_to_file(lines, included_lines, d_tmp_trace_file_name);
             superset    = superset_cur;
             n_lines_cur = superset.size();
             subset_size = n_lines_cur / 2;
@@ -761,7 +1141,6 @@ bool
 DD::minimize_line_aux(Result golden_exit,
                       std::vector<std::vector<std::string>>& lines,
                       const std::vector<size_t>& included_lines,
-                      const std::string& input_trace_file_name,
                       size_t n_args,
                       const std::vector<std::tuple<uint64_t,
                                                    size_t,
@@ -810,7 +1189,7 @@ DD::minimize_line_aux(Result golden_exit,
 
       /* test if minimization was successful */
       std::vector<size_t> tmp_superset =
-          test(golden_exit, lines, included_lines, input_trace_file_name);
+          test(golden_exit, lines, included_lines);
 
       if (!tmp_superset.empty())
       {
@@ -833,8 +1212,6 @@ DD::minimize_line_aux(Result golden_exit,
     }
     else
     {
-      /* write to file and continue */
-      write_lines_to_file(lines, included_lines, d_tmp_trace_file_name);
       line_superset = cur_line_superset;
       subset_size   = line_superset.size() / 2;
       res           = true;
@@ -851,8 +1228,7 @@ DD::minimize_line_aux(Result golden_exit,
 bool
 DD::minimize_line(Result golden_exit,
                   std::vector<std::vector<std::string>>& lines,
-                  const std::vector<size_t>& included_lines,
-                  const std::string& input_trace_file_name)
+                  const std::vector<size_t>& included_lines)
 {
   MURXLA_MESSAGE_DD << "trying to minimize trace lines ...";
 
@@ -960,7 +1336,6 @@ DD::minimize_line(Result golden_exit,
       if (minimize_line_aux(golden_exit,
                             lines,
                             included_lines,
-                            input_trace_file_name,
                             n_args,
                             to_minimize))
       {
@@ -974,68 +1349,230 @@ DD::minimize_line(Result golden_exit,
 std::vector<size_t>
 DD::test(Result golden_exit,
          const std::vector<std::vector<std::string>>& lines,
-         const std::vector<size_t>& superset,
-         const std::string& untrace_file_name)
+         const std::vector<size_t>& superset)
 {
   std::vector<size_t> res_superset;
-  std::string tmp_out_file_name =
-      get_tmp_file_path("tmp-dd.out", d_murxla->d_tmp_dir);
-  std::string tmp_err_file_name =
-      get_tmp_file_path("tmp-dd.err", d_murxla->d_tmp_dir);
-
-  write_lines_to_file(lines, superset, untrace_file_name);
-  /* while delta debugging, do not trace to file or stdout */
-  Result exit = d_murxla->run(d_seed,
-                              d_time,
-                              tmp_out_file_name,
-                              tmp_err_file_name,
-                              "",
-                              untrace_file_name,
-                              true,
-                              false,
-                              Murxla::TraceMode::NONE);
+  std::string out, err;
+  Result exit = RESULT_UNKNOWN;
+  bool use_snapshot = false;
+
+  /* Candidates may be proposed several times by different passes and
+   * iterations, we only test them once as long as the trace lines are not
+   * modified. */
+  if (d_memo_lines != lines)
+  {
+    d_memo.clear();
+    d_memo_lines = lines;
+  }
+  auto it = d_memo.find(superset);
+  if (it != d_memo.end())
+  {
+    if (it->second) res_superset = superset;
+    return res_superset;
+  }
+
+  if (d_test || d_murxla->d_options.dd_slow > 0)
+  {
+    bool res = d_test ? d_test(lines, superset) : test_slow(lines, superset);
+    d_ntests += 1;
+    if (res)
+    {
+      res_superset = superset;
+      d_ntests_success += 1;
+    }
+    d_memo.emplace(superset, res);
+    if (res)
+    {
+      save_checkpoint(lines, superset);
+    }
+    return res_superset;
+  }
+
+  /* Abort test runs as soon as their output diverges from the golden output,
+   * i.e., as soon as it is no longer a prefix of the golden output. */
+  bool check_out = !d_murxla->d_options.dd_ignore_out
+                   && d_murxla->d_options.dd_match_out.empty();
+  bool check_err = !d_murxla->d_options.dd_ignore_err
+                   && d_murxla->d_options.dd_match_err.empty();
+  auto is_prefix = [](const std::string& s, const std::string& gold) {
+    return s.size() <= gold.size() && gold.compare(0, s.size(), s) == 0;
+  };
+  Murxla::OutputCheck check = [&](const std::string& out,
+                                  const std::string& err) {
+    return (!check_out || is_prefix(out, d_gold_out))
+           && (!check_err || is_prefix(err, d_gold_err));
+  };
+
+  /* If the candidate shares a prefix with the snapshot, only replay the
+   * suffix in a process forked off the snapshot process. */
+  size_t n_prefix = get_snapshot_prefix_size(lines, superset);
+  if (n_prefix > 0)
+  {
+    std::stringstream suffix;
+    write_lines(
+        suffix,
+        lines,
+        std::vector<size_t>(superset.begin() + n_prefix, superset.end()));
+    exit = d_murxla->run_snapshot(d_time, suffix.str(), out, err, check);
+    use_snapshot = d_murxla->has_snapshot();
+  }
+
+  /* no snapshot, or snapshot process died */
+  if (!use_snapshot)
+  {
+    auto start = std::chrono::steady_clock::now();
+    exit = d_murxla->run_lines(d_seed, d_time, lines, superset, out, err, check);
+    auto end = std::chrono::steady_clock::now();
+    /* Adapt the time limit to the runtime of the last successful test run.
+     * Runs on the snapshot only replay the suffix and are not considered. */
+    if (exit == golden_exit)
+    {
+      d_time = std::max(MURXLA_DD_TIME_MIN,
+                        std::chrono::duration<double>(end - start).count()
+                            * MURXLA_DD_TIME_FACTOR);
+    }
+  }
+
   d_ntests += 1;
   if (exit == golden_exit
       && (d_murxla->d_options.dd_ignore_out
           || (!d_murxla->d_options.dd_match_out.empty()
-              && find_in_file(
-                  tmp_err_file_name, d_murxla->d_options.dd_match_out, false))
-          || compare_files(tmp_out_file_name, d_gold_out_file_name))
+              && out.find(d_murxla->d_options.dd_match_out)
+                     != std::string::npos)
+          || (out.size() == d_gold_out.size()
+              && std::hash<std::string>{}(out) == d_gold_out_hash))
       && (d_murxla->d_options.dd_ignore_err
           || (!d_murxla->d_options.dd_match_err.empty()
-              && find_in_file(
-                  tmp_err_file_name, d_murxla->d_options.dd_match_err, false))
-          || compare_files(tmp_err_file_name, d_gold_err_file_name)))
+              && err.find(d_murxla->d_options.dd_match_err)
+                     != std::string::npos)
+          || (err.size() == d_gold_err.size()
+              && std::hash<std::string>{}(err) == d_gold_err_hash)))
   {
     res_superset = superset;
     d_ntests_success += 1;
   }
+  /* Runs may time out due to the adapted time limit, do not cache them since
+   * they may succeed with a later time limit. */
+  if (exit != RESULT_TIMEOUT || !res_superset.empty())
+  {
+    d_memo.emplace(superset, !res_superset.empty());
+  }
+  if (!res_superset.empty())
+  {
+    save_checkpoint(lines, superset);
+  }
   return res_superset;
 }
 
-void
-DD::write_lines_to_file(const std::vector<std::vector<std::string>>& lines,
-                        const std::vector<size_t> indices,
-                        const std::string& out_file_name)
+bool
+DD::test_slow(const std::vector<std::vector<std::string>>& lines,
+              const std::vector<size_t>& superset)
 {
-  size_t size            = lines.size();
-  std::ofstream out_file = open_output_file(out_file_name, false);
-  if (!d_options_line.empty())
+  std::string out, err;
+  double time_limit = d_murxla->d_options.dd_slow;
+  Murxla::OutputCheck check = [](const std::string&, const std::string&) {
+    return true;
+  };
+
+  /* Snapshots are not used since replaying only the suffix of a candidate
+   * does not measure its runtime.  Runs are terminated as soon as they exceed
+   * the time limit, a single run that finishes in time rejects the
+   * candidate. */
+  for (size_t i = 0; i < MURXLA_DD_SLOW_RUNS; ++i)
   {
-    out_file << d_options_line << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    Result exit =
+        d_murxla->run_lines(d_seed, d_time, lines, superset, out, err, check);
+    auto end = std::chrono::steady_clock::now();
+    double time = std::chrono::duration<double>(end - start).count();
+    if (exit != RESULT_TIMEOUT && time < time_limit)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t
+DD::get_snapshot_prefix_size(const std::vector<std::vector<std::string>>& lines,
+                             const std::vector<size_t>& superset)
+{
+  size_t n_lines = superset.size();
+  std::vector<std::vector<std::string>> candidate;
+  candidate.reserve(n_lines);
+  for (size_t idx : superset)
+  {
+    candidate.push_back(lines[idx]);
+  }
+
+  size_t res = 0;
+
+  /* Check if the prefix of the current snapshot can be reused. */
+  size_t n_prefix = d_snapshot_prefix.size();
+  if (d_murxla->has_snapshot() && n_prefix < n_lines
+      && std::equal(d_snapshot_prefix.begin(),
+                    d_snapshot_prefix.end(),
+                    candidate.begin()))
+  {
+    res = n_prefix;
   }
+  /* Else, start a new snapshot for the common prefix of this candidate and the
+   * previously tested candidate.  Consecutive candidates usually only differ
+   * in lines after this prefix. */
+  else
+  {
+    size_t n_common = 0;
+    for (size_t n = std::min(n_lines - 1, d_last_candidate.size());
+         n_common < n && candidate[n_common] == d_last_candidate[n_common];
+         ++n_common)
+      ;
+    d_snapshot_prefix.clear();
+    if (n_common > 0)
+    {
+      std::vector<size_t> prefix(superset.begin(), superset.begin() + n_common);
+      if (d_murxla->start_snapshot(d_seed, d_time, lines, prefix))
+      {
+        d_snapshot_prefix.assign(candidate.begin(),
+                                 candidate.begin() + n_common);
+        res = n_common;
+      }
+    }
+  }
+  d_last_candidate = std::move(candidate);
+  return res;
+}
+
+void
+DD::write_lines(std::ostream& out,
+                const std::vector<std::vector<std::string>>& lines,
+                const std::vector<size_t>& indices)
+{
+  size_t size = lines.size();
   for (size_t idx : indices)
   {
     assert(idx < size);
     assert(lines[idx].size() > 0);
     assert(lines[idx].size() <= 2);
-    out_file << lines[idx][0];
+    out << lines[idx][0];
     if (lines[idx].size() == 2)
     {
-      out_file << std::endl << lines[idx][1];
+      out << std::endl << lines[idx][1];
     }
-    out_file << std::endl;
+    out << std::endl;
+  }
+}
+
+void
+DD::write_lines_to_file(const std::vector<std::vector<std::string>>& lines,
+                        const std::vector<size_t> indices,
+                        const std::string& out_file_name)
+{
+  std::ofstream out_file = open_output_file(out_file_name, false);
+  if (!d_options_line.empty())
+  {
+    out_file << d_options_line << std::endl;
   }
+  write_lines(out_file, lines, indices);
   out_file.close();
 }
 
@@ -10,8 +10,12 @@
 #ifndef __MURXLA__DD_H
 #define __MURXLA__DD_H
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "action.hpp"
@@ -27,6 +31,14 @@ class DD
   /** The default api trace file name for temporary trace files. */
   inline static const std::string API_TRACE    = "tmp-dd-api.trace";
 
+  /**
+   * The test oracle.  Determines if the candidate trace given by the lines in
+   * 'lines' at the indices in 'superset' still shows the behavior to preserve.
+   */
+  using TestFunction =
+      std::function<bool(const std::vector<std::vector<std::string>>& lines,
+                         const std::vector<size_t>& superset)>;
+
   /**
    * Constructor.
    *
@@ -46,21 +58,105 @@ class DD
   void run(const std::string& input_trace_file_name,
            std::string reduced_trace_file_name);
 
- private:
+  /**
+   * Write trace lines to output stream.
+   *
+   * A trace is represented as a vector of lines and a line is represented as a
+   * vector of strings with at most 2 elements (see write_lines_to_file()).
+   *
+   * out    : The output stream to write to.
+   * lines  : The trace lines.
+   * indices: The indices of the lines in 'lines' to write.
+   */
+  static void write_lines(std::ostream& out,
+                          const std::vector<std::vector<std::string>>& lines,
+                          const std::vector<size_t>& indices);
+
+  /**
+   * Set the test oracle, which replaces replaying candidate traces via
+   * Murxla::run_lines().  This allows to benchmark the delta debugging
+   * passes independently from the solver.
+   */
+  void set_test_function(TestFunction test);
+
+  /**
+   * Minimize the number of trace lines by removing subsets of lines, starting
+   * with halves of the included lines.  Subsets that remove definitions of
+   * sorts or terms that are still used are skipped.
+   *
+   * golden_exit   : The exit code of the original trace.
+   * lines         : The trace lines.
+   * included_lines: The indices of the included lines, updated with the
+   *                 minimized set of lines.
+   *
+   * Returns true if the number of included lines was reduced.
+   */
   bool minimize_lines(Result golden_exit,
                       const std::vector<std::vector<std::string>>& lines,
-                      std::vector<size_t>& included_lines,
-                      const std::string& input_trace_file_name);
+                      std::vector<size_t>& included_lines);
+
+ private:
+  /** The delta debugging passes, in the order they are applied. */
+  enum Pass
+  {
+    PASS_MINIMIZE_LINES_DEPS,
+    PASS_MINIMIZE_LINES,
+    PASS_MINIMIZE_LINE,
+    PASS_SUBSTITUTE_TERMS,
+  };
+
+  /** Start given pass and checkpoint the current state. */
+  void start_pass(Pass pass,
+                  const std::vector<std::vector<std::string>>& lines,
+                  const std::vector<size_t>& included_lines);
+
+  /**
+   * Save the current delta debugging state to the checkpoint file.
+   *
+   * The checkpoint contains the current (minimized) trace lines, the set of
+   * included lines, the current pass and iteration and the cache of test
+   * results, together with the hash of the input trace and the result of
+   * the golden run it was created for.  It is written to the output
+   * directory, next to the reduced trace, and allows to resume an
+   * interrupted run via --dd-resume.
+   *
+   * lines         : The current trace lines.
+   * included_lines: The current set of included lines.
+   * force         : True to write the checkpoint even if the last checkpoint
+   *                 was written less than MURXLA_DD_CHECKPOINT_INTERVAL
+   *                 seconds (or MURXLA_DD_CHECKPOINT_OVERHEAD_FACTOR times
+   *                 the time it took to write it) ago.
+   */
+  void save_checkpoint(const std::vector<std::vector<std::string>>& lines,
+                       const std::vector<size_t>& included_lines,
+                       bool force = false);
+
+  /**
+   * Restore the delta debugging state from the checkpoint file.
+   * Checkpoints of a different input trace or golden run are ignored.
+   */
+  void load_checkpoint(std::vector<std::vector<std::string>>& lines,
+                       std::vector<size_t>& included_lines);
+
+  /**
+   * Minimize the number of trace lines by removing sets of lines together
+   * with all lines that (transitively) use the sorts and terms they define.
+   *
+   * Candidates are derived from the def-use graph of sort and term ids, and
+   * are thus always closed under dependencies.
+   */
+  bool minimize_lines_dependencies(
+      Result golden_exit,
+      const std::vector<std::vector<std::string>>& lines,
+      std::vector<size_t>& included_lines);
 
   bool minimize_line(Result golden_exit,
                      std::vector<std::vector<std::string>>& lines,
-                     const std::vector<size_t>& included_lines,
-                     const std::string& input_trace_file_name);
+                     const std::vector<size_t>& included_lines);
 
   bool minimize_line_aux(Result golden_exit,
                          std::vector<std::vector<std::string>>& lines,
                          const std::vector<size_t>& included_lines,
-                         const std::string& input_trace_file_name,
                          size_t n_args,
                          const std::vector<std::tuple<uint64_t,
                                                       size_t,
@@ -70,13 +166,32 @@ class DD
 
   bool substitute_terms(Result golden_exit,
                         std::vector<std::vector<std::string>>& lines,
-                        std::vector<size_t>& included_lines,
-                        const std::string& input_trace_file_name);
+                        std::vector<size_t>& included_lines);
 
   std::vector<size_t> test(Result golden_exit,
                            const std::vector<std::vector<std::string>>& lines,
-                           const std::vector<size_t>& superset,
-                           const std::string& input_trace_file_name);
+                           const std::vector<size_t>& superset);
+
+  /**
+   * Test if the candidate trace given by 'superset' still exceeds the time
+   * limit given via --dd-slow in MURXLA_DD_SLOW_RUNS consecutive runs.
+   */
+  bool test_slow(const std::vector<std::vector<std::string>>& lines,
+                 const std::vector<size_t>& superset);
+
+  /**
+   * Determine the number of leading lines of the candidate trace given by
+   * 'superset' that are already replayed by the snapshot process (see
+   * Murxla::start_snapshot()).
+   *
+   * If the current snapshot can not be reused, a new snapshot is started for
+   * the common prefix of this and the previously tested candidate.
+   *
+   * Returns 0 if no snapshot can be used for this candidate.
+   */
+  size_t get_snapshot_prefix_size(
+      const std::vector<std::vector<std::string>>& lines,
+      const std::vector<size_t>& superset);
 
   /**
    * Write trace lines to output file.
@@ -100,6 +215,8 @@ class DD
 
   /** The associated Murxla instance. */
   Murxla* d_murxla = nullptr;
+  /** The test oracle, replaces replaying candidate traces if set. */
+  TestFunction d_test;
   /** The directory for output files (default: current). */
   std::string d_out_dir = "";
   /** The directory for temp files. */
@@ -117,10 +234,46 @@ class DD
   std::string d_gold_out_file_name;
   /** The error output file name for the initial dd test run. */
   std::string d_gold_err_file_name;
-  /** The temp trace file name for dd. */
-  std::string d_tmp_trace_file_name;
+  /** The stdout output of the initial dd test run. */
+  std::string d_gold_out;
+  /** The stderr output of the initial dd test run. */
+  std::string d_gold_err;
+  /** The hash of the stdout output of the initial dd test run. */
+  size_t d_gold_out_hash = 0;
+  /** The hash of the stderr output of the initial dd test run. */
+  size_t d_gold_err_hash = 0;
+  /** The exit of the initial dd test run. */
+  Result d_gold_exit = RESULT_UNKNOWN;
   /** The trace line configuring murxla options. */
   std::string d_options_line;
+  /** The hash of the input trace, identifies the trace of a checkpoint. */
+  uint64_t d_input_hash = 0;
+
+  /** The trace lines replayed by the current snapshot process. */
+  std::vector<std::vector<std::string>> d_snapshot_prefix;
+  /** The trace lines of the previously tested candidate. */
+  std::vector<std::vector<std::string>> d_last_candidate;
+
+  /** The name of the checkpoint file. */
+  std::string d_checkpoint_file_name;
+  /** The time the last checkpoint was written. */
+  std::chrono::steady_clock::time_point d_checkpoint_time;
+  /** The time in seconds it took to write the last checkpoint. */
+  double d_checkpoint_write_time = 0;
+  /** The current pass. */
+  Pass d_pass = PASS_MINIMIZE_LINES_DEPS;
+  /** The current iteration. */
+  uint64_t d_iteration = 0;
+  /** True if no pass of the current iteration modified the trace. */
+  bool d_fixed_point = true;
+  /**
+   * Cache of test results, maps the line indices of a candidate trace to the
+   * result.  The cached results refer to the trace lines in d_memo_lines and
+   * are dropped when the lines are modified.
+   */
+  std::map<std::vector<size_t>, bool> d_memo;
+  /** The trace lines the cached test results in d_memo refer to. */
+  std::vector<std::vector<std::string>> d_memo_lines;
 };
 
 }  // namespace murxla
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -60,20 +61,27 @@ State::run(RNGenerator& rng)
   ActionTuple& atup = d_actions[idx];
 
   /* record state statistics */
-  ++d_mbt_stats->d_states[get_id()];
+  ++d_mbt_stats->shard().d_states[get_id()];
 
   assert(f_precond == nullptr || f_precond());
 
   /* record action statistics */
-  ++d_mbt_stats->d_actions[atup.d_action->get_id()];
+  ++d_mbt_stats->shard().d_actions[atup.d_action->get_id()];
+  d_mbt_stats->shard().set_cur_action(atup.d_action->get_id());
 
   /* run action */
   atup.d_action->seed_solver_rng();
-  if (atup.d_action->generate()
+  bool success;
+  {
+    statistics::ScopedTimer timer(
+        d_mbt_stats->shard().d_action_times[atup.d_action->get_id()]);
+    success = atup.d_action->generate();
+  }
+  if (success
       && (atup.d_next->f_precond == nullptr || atup.d_next->f_precond()))
   {
     /* record action statistics */
-    ++d_mbt_stats->d_actions_ok[atup.d_action->get_id()];
+    ++d_mbt_stats->shard().d_actions_ok[atup.d_action->get_id()];
 
     return d_actions[idx].d_next;
   }
@@ -102,6 +110,7 @@ FSM::FSM(RNGenerator& rng,
          SolverOptions& options,
          bool arith_linear,
          bool simple_symbols,
+         double perf_time,
          bool smtlib_compliant,
          bool fuzz_options,
          std::string fuzz_options_filter,
@@ -118,6 +127,7 @@ FSM::FSM(RNGenerator& rng,
              options,
              arith_linear,
              simple_symbols,
+             perf_time,
              stats,
              enabled_theories,
              disabled_theories),
@@ -131,7 +141,7 @@ FSM::FSM(RNGenerator& rng,
       d_solver_profile(solver_profile)
 {
   auto smgr_enabled_theories = d_smgr.get_enabled_theories();
-  auto unsupported_theory_combinations =
+  const auto& unsupported_theory_combinations =
       d_solver_profile.get_unsupported_theory_combinations();
 
   for (const auto& [theory, theory_list] : unsupported_theory_combinations)
@@ -341,6 +351,61 @@ FSM::run()
   }
 }
 
+void
+FSM::resume()
+{
+  if (d_untraced_action == nullptr)
+  {
+    run();
+    return;
+  }
+
+  if (d_untraced_state == nullptr)
+  {
+    throw MurxlaUntraceException(d_untraced_file_name,
+                                 d_untraced_state_nline,
+                                 "unable to resume, " + d_untraced_state_error);
+  }
+  d_state_cur = d_untraced_state;
+  run();
+}
+
+State*
+FSM::find_untrace_state(State* state, Action* action)
+{
+  /* Breadth-first search over transitions, which are not traced.  Action
+   * 'set-option-req' traces its options as 'set-option', it is followed like
+   * a transition without running it. */
+  std::vector<State*> visit{state};
+  std::unordered_set<State*> visited{state};
+  for (size_t i = 0; i < visit.size(); ++i)
+  {
+    State* s = visit[i];
+    for (size_t j = 0, n = s->d_actions.size(); j < n; ++j)
+    {
+      if (s->d_actions[j].d_action == action && s->d_weights[j] > 0)
+      {
+        return s;
+      }
+    }
+    for (size_t j = 0, n = s->d_actions.size(); j < n; ++j)
+    {
+      Action* a  = s->d_actions[j].d_action;
+      State* next = s->d_actions[j].d_next;
+      if (s->d_weights[j] == 0 || visited.count(next)
+          || (a->empty() ? !a->generate()
+                         : a->get_kind() != ActionSetOptionReq::s_name)
+          || (next->f_precond != nullptr && !next->f_precond()))
+      {
+        continue;
+      }
+      visit.push_back(next);
+      visited.insert(next);
+    }
+  }
+  return nullptr;
+}
+
 /* ========================================================================== */
 /* Configure default FSM                                                      */
 /* ========================================================================== */
@@ -609,6 +674,21 @@ FSM::configure()
   }
 }
 
+void
+FSM::scale_action_weights(const std::vector<double>& factors)
+{
+  for (const auto& s : d_states)
+  {
+    for (size_t i = 0, n = s->d_actions.size(); i < n; ++i)
+    {
+      uint32_t& w = s->d_weights[i];
+      uint64_t id = s->d_actions[i].d_action->get_id();
+      if (w == 0 || id >= factors.size()) continue;
+      w = std::max(1u, static_cast<uint32_t>(std::lround(w * factors[id])));
+    }
+  }
+}
+
 void
 FSM::print() const
 {
@@ -671,20 +751,66 @@ FSM::untrace(const std::string& trace_file_name)
 {
   assert(!trace_file_name.empty());
 
+  std::ifstream trace;
+  trace.open(trace_file_name);
+  MURXLA_CHECK_CONFIG(trace.is_open())
+      << "untrace: unable to open file '" << trace_file_name << "'";
+
+  untrace(trace, trace_file_name);
+
+  trace.close();
+}
+
+namespace {
+
+/**
+ * Get the number of a simple symbol generated by SolverManager::pick_symbol(),
+ * e.g., 12 for "_x12".  Returns false if given token is not such a symbol.
+ */
+bool
+get_symbol_number(const std::string& token, uint32_t& number)
+{
+  size_t n = token.size();
+  if (n < 4 || token[0] != '"' || token[1] != '_' || token[n - 1] != '"')
+  {
+    return false;
+  }
+  size_t i = n - 1;
+  while (i > 2 && std::isdigit(token[i - 1])) --i;
+  if (i == n - 1 || !std::isalpha(token[i - 1])) return false;
+  number = str_to_uint32(token.substr(i, n - 1 - i));
+  return true;
+}
+
+/**
+ * The kinds of actions that are also traced while running other actions,
+ * e.g., 'mk-var' for the variables created by 'mk-term' and 'mk-fun'.
+ */
+const std::unordered_set<Action::Kind> s_nested_action_kinds = {
+    ActionInstantiateSort::s_name,
+    ActionMkTerm::s_name,
+    ActionMkVar::s_name,
+};
+
+}  // namespace
+
+void
+FSM::untrace(std::istream& trace, const std::string& trace_file_name)
+{
   uint32_t nline   = 0;
   std::vector<uint64_t> ret_val;
   Action* ret_action;
   std::string line;
-  std::ifstream trace;
   bool sng_untrace_mode = d_smgr.get_sng().is_untrace_mode();
 
   /* Set mode to untracing. We keep the untraced solver seeds when untracing
    * and do not generate new solver seeds. */
   d_smgr.get_sng().set_untrace_mode(true);
 
-  trace.open(trace_file_name);
-  MURXLA_CHECK_CONFIG(trace.is_open())
-      << "untrace: unable to open file '" << trace_file_name << "'";
+  d_untraced_state       = d_state_cur;
+  d_untraced_file_name   = trace_file_name;
+  d_untraced_state_nline = 0;
+  d_untraced_state_error.clear();
 
   try
   {
@@ -713,6 +839,41 @@ FSM::untrace(const std::string& trace_file_name)
         }
 
         Action* action = d_actions.at(id).get();
+        d_untraced_action = action;
+
+        /* Track the state the replayed action is performed in.  Actions that
+         * are not enabled in any reachable state may have been traced while
+         * running another action, they do not change the state. */
+        State* state = nullptr;
+        bool nested  = false;
+        if (d_untraced_state != nullptr)
+        {
+          state = find_untrace_state(d_untraced_state, action);
+          if (state == nullptr && s_nested_action_kinds.count(id))
+          {
+            nested = true;
+          }
+          else if (state == nullptr)
+          {
+            d_untraced_state_nline = nline;
+            d_untraced_state_error = "action '" + id
+                                     + "' is not enabled in any state "
+                                       "reachable from state '"
+                                     + d_untraced_state->get_kind() + "'";
+          }
+        }
+
+        /* Symbols generated after resuming must not clash with untraced
+         * symbols. */
+        for (const auto& token : tokens)
+        {
+          uint32_t number;
+          if (get_symbol_number(token, number))
+          {
+            d_smgr.d_n_symbols = std::max(d_smgr.d_n_symbols, number + 1);
+          }
+        }
+        d_mbt_stats->shard().set_cur_action(action->get_id());
         if (!d_smgr.get_solver().is_initialized()
             && action->get_kind() != ActionNew::s_name)
         {
@@ -821,6 +982,23 @@ FSM::untrace(const std::string& trace_file_name)
           }
           ret_val = {};
         }
+
+        /* Transition into the next state as in State::run(). */
+        if (!nested) d_untraced_state = state;
+        if (state != nullptr)
+        {
+          for (size_t i = 0, n = state->d_actions.size(); i < n; ++i)
+          {
+            State* next = state->d_actions[i].d_next;
+            if (state->d_actions[i].d_action == action
+                && state->d_weights[i] > 0
+                && (next->f_precond == nullptr || next->f_precond()))
+            {
+              d_untraced_state = next;
+              break;
+            }
+          }
+        }
       }
     }
   }
@@ -828,8 +1006,6 @@ FSM::untrace(const std::string& trace_file_name)
   {
     throw MurxlaUntraceException(trace_file_name, nline, e.get_msg());
   }
-  if (trace.is_open()) trace.close();
-
   /* reset to previous mode */
   d_smgr.get_sng().set_untrace_mode(sng_untrace_mode);
 }
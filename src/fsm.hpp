@@ -391,6 +391,7 @@ class FSM
       SolverOptions& options,
       bool arith_linear,
       bool simple_symbols,
+      double perf_time,
       bool smtlib_compliant,
       bool fuzz_options,
       std::string fuzz_options_filter,
@@ -575,10 +576,31 @@ class FSM
   void configure();
   /** Replay given trace. */
   void untrace(const std::string& trace_file_name);
+  /**
+   * Replay trace read from given input stream.
+   * trace     : The input stream to read the trace from.
+   * trace_name: The name of the trace, used for error messages.
+   */
+  void untrace(std::istream& trace, const std::string& trace_name);
+  /**
+   * Continue with random generation after replaying a trace (prefix) via
+   * untrace().  The state to resume from is the state untrace() ended in,
+   * nothing is generated if that is the final state.
+   * Throws a MurxlaUntraceException if the replayed actions do not
+   * correspond to a path of this FSM.
+   */
+  void resume();
 
   /** Print the current configuration of this FSM to stdout. */
   void print() const;
 
+  /**
+   * Scale the weights of the configured actions of all states.
+   * factors: The weight factors, indexed by action id. Actions without factor
+   *          and disabled actions are not affected.
+   */
+  void scale_action_weights(const std::vector<double>& factors);
+
  private:
   /** The solver manager. */
   SolverManager d_smgr;
@@ -619,6 +641,32 @@ class FSM
   State* d_state_init = nullptr;
   /** The current state. */
   State* d_state_cur = nullptr;
+  /**
+   * Find the state that untrace() replays given action in.  This is given
+   * state if the action is enabled in it, else the nearest state the action
+   * is enabled in that is reachable via (untraced) transitions from given
+   * state.
+   * Returns nullptr if no such state exists.
+   */
+  State* find_untrace_state(State* state, Action* action);
+
+  /** The last action replayed by untrace(), nullptr if none. */
+  Action* d_untraced_action = nullptr;
+  /**
+   * The state untrace() ended in, determined by following the transitions
+   * of the replayed actions from the initial state.  Nullptr if the replayed
+   * actions do not correspond to a path of this FSM.
+   */
+  State* d_untraced_state = nullptr;
+  /** The untraced file, for error messages of resume(). */
+  std::string d_untraced_file_name;
+  /** The line of the first untraced action without a state, or 0. */
+  uint32_t d_untraced_state_nline = 0;
+  /**
+   * The reason why the untraced action at d_untraced_state_nline has no
+   * state, for error messages of resume().
+   */
+  std::string d_untraced_state_error;
 
   /** True to restrict arithmetic to the linear fragment. */
   bool d_arith_linear = false;
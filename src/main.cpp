@@ -20,16 +20,19 @@
 #include <ctime>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <numeric>
 #include <regex>
 #include <sstream>
+#include <thread>
 
 #include "dd.hpp"
 #include "except.hpp"
 #include "exit.hpp"
 #include "murxla.hpp"
 #include "options.hpp"
+#include "smt2_store.hpp"
 #include "solver_option.hpp"
 #include "statistics.hpp"
 #include "util.hpp"
@@ -44,24 +47,12 @@ static std::string TMP_DIR = "";
 
 /** Map normalized error message to pair (original error message, seeds). */
 static Murxla::ErrorMap g_errors;
+/** Map timeout group (the hanging action) to pair (message, seeds). */
+static Murxla::ErrorMap g_timeouts;
 static bool g_errors_print_csv = false;
 
 /* -------------------------------------------------------------------------- */
 
-static Statistics*
-initialize_statistics()
-{
-  Statistics* stats;
-  stats = static_cast<Statistics*>(mmap(0,
-                                        sizeof(Statistics),
-                                        PROT_READ | PROT_WRITE,
-                                        MAP_ANONYMOUS | MAP_SHARED,
-                                        -1,
-                                        0));
-  memset(stats, 0, sizeof(Statistics));
-  return stats;
-}
-
 static bool
 path_is_dir(const std::string& path)
 {
@@ -144,6 +135,28 @@ print_error_summary()
       }
     }
   }
+  if (g_timeouts.size())
+  {
+    std::cout << "\nTimeout statistics (" << g_timeouts.size()
+              << " in total):\n"
+              << std::endl;
+
+    Terminal term;
+    for (const auto& [t_key, t_info] : g_timeouts)
+    {
+      std::cout << term.blue() << t_info.seeds.size()
+                << " timeouts: " << term.defaultcolor();
+      for (size_t i = 0; i < std::min<size_t>(t_info.seeds.size(), 10); ++i)
+      {
+        if (i > 0)
+        {
+          std::cout << " ";
+        }
+        std::cout << std::hex << t_info.seeds[i] << std::dec;
+      }
+      std::cout << "\n" << t_info.errmsg << "\n" << std::endl;
+    }
+  }
 }
 
 /* -------------------------------------------------------------------------- */
@@ -194,6 +207,7 @@ set_sigint_handler_stats(void)
   "  -l, --smt-lib              generate SMT-LIB compliant traces only\n"      \
   "  -y, --random-symbols       use random symbol names\n"                     \
   "  --stats                    print statistics\n"                            \
+  "  --stats-json <file>        export statistics to <file> in JSON format\n"  \
   "  --print-fsm                print FSM configuration, may be combined\n"    \
   "                             with solver option to show config for \n"      \
   "\n"                                                                         \
@@ -202,6 +216,17 @@ set_sigint_handler_stats(void)
   "  -m, --max-runs <int>       limit number of test runs\n"                   \
   "  --csv                      print error summary in csv format\n"           \
   "  -e, --export-errors <out>  export found errors to JSON file <out>\n"      \
+  "  --stats-file <file>        periodically write a JSON status snapshot\n"   \
+  "                             to <file>\n"                                   \
+  "  --cov-feedback             weight actions and operators by new solver\n"  \
+  "                             code coverage, requires a solver built with\n" \
+  "                             -fsanitize-coverage=trace-pc-guard\n"          \
+  "  --cov-weights <file>       load and persist learned coverage weights\n"   \
+  "                             in <file>, implies --cov-feedback\n"           \
+  "  --corpus <dir>             keep traces of runs with new coverage or\n"    \
+  "                             new result/option combinations in <dir>\n"     \
+  "  --mutate                   resume runs from random prefixes of corpus\n"  \
+  "                             traces, requires --corpus\n"                   \
   "\n"                                                                         \
   " One-shot mode options:\n"                                                  \
   "  -s, --seed <int>           seed for random number generator\n"            \
@@ -210,6 +235,11 @@ set_sigint_handler_stats(void)
   "  -u, --untrace <file>       replay given API call sequence\n"              \
   "  --solver-trace             print native solver API trace to stdout\n"     \
   "\n"                                                                         \
+  " Batch replay options:\n"                                                   \
+  "  --replay-dir <dir>         replay all traces in <dir> and report which\n" \
+  "                             are fixed, still failing or timing out\n"      \
+  "  -j, --jobs <int>           number of parallel workers for --replay-dir\n" \
+  "\n"                                                                         \
   " Trace minimizer:\n"                                                        \
   "  -d, --dd                   enable delta debugging\n"                      \
   "  --dd-match-err <string>    check for occurrence of <string> in stderr\n"  \
@@ -219,15 +249,25 @@ set_sigint_handler_stats(void)
   "  --dd-ignore-err            ignore stderr output when delta debugging\n"   \
   "  --dd-ignore-out            ignore stdout output when delta debugging\n"   \
   "  -D, --dd-trace <file>      delta debug API trace into <file>\n"           \
+  "  --dd-resume                resume delta debugging from checkpoint\n"      \
+  "  --dd-slow <double>         delta debug for slowdown, keep traces that\n"  \
+  "                             take more than <double> seconds\n"             \
   "\n"                                                                         \
   " Solvers:\n"                                                                \
   "  --btor                     test Boolector\n"                              \
   "  --bzla                     test Bitwuzla\n"                               \
   "  --cvc5                     test cvc5\n"                                   \
   "  --yices                    test Yices\n"                                  \
+  "  --mock                     test mock solver with random results\n"        \
   "  --smt2 [<binary>]          print SMT-LIB 2 (optionally to solver "        \
   "binary\n"                                                                   \
   "                             via stdout)\n"                                 \
+  "  --smt2-pipeline            stream commands to online SMT2 solver\n"       \
+  "                             without waiting for 'success' responses\n"     \
+  "  --smt2-store <dir>         store offline --smt2 output files compressed\n"\
+  "                             and without duplicates in <dir>\n"             \
+  "  --smt2-extract <dir>       extract SMT2 files stored in <dir> into the\n" \
+  "                             output directory and exit\n"                   \
   "  -o name=value,...          solver options enabled by default\n"           \
   "  --fuzz-opts [wildcard,...] restrict options to be fuzzed with multiple\n" \
   "                             wildcards, which are matched against option\n" \
@@ -236,6 +276,16 @@ set_sigint_handler_stats(void)
   "  -c, --cross-check <solver> cross check with <solver> (SMT-LIB only)\n"    \
   "  --cross-check-opts name=value,...\n"                                      \
   "                             options for cross check solver\n"              \
+  "  --cross-check-concurrent   run expensive calls of the solver and the\n"   \
+  "                             cross check solver concurrently\n"             \
+  "  --vote <solver>,...        test against all given solvers in parallel\n"  \
+  "                             and check results by majority vote\n"          \
+  "  --perf-time <double>       report check-sat calls taking longer than\n"   \
+  "                             <double> seconds as performance anomaly\n"     \
+  "  --perf-ratio <double>      report check-sat calls taking more than\n"     \
+  "                             <double> times as long as with the cross\n"    \
+  "                             check (or vote) solvers as performance\n"      \
+  "                             anomaly\n"                                     \
   "  -C, --check [<solver>]     check unsat cores/assumptions and \n"          \
   "                             model values with <solver>\n"                  \
   "\n"                                                                         \
@@ -301,7 +351,7 @@ bool
 is_valid_solver_str(const std::string& name)
 {
   return name == SOLVER_BTOR || name == SOLVER_BZLA || name == SOLVER_CVC5
-         || name == SOLVER_YICES;
+         || name == SOLVER_YICES || name == SOLVER_MOCK;
 }
 
 void
@@ -431,6 +481,16 @@ parse_options(Options& options, int argc, char* argv[])
       check_next_arg(arg, i, size);
       options.dd_trace_file_name = args[i];
     }
+    else if (arg == "--dd-resume")
+    {
+      options.dd_resume = true;
+    }
+    else if (arg == "--dd-slow")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.dd_slow = std::atof(args[i].c_str());
+    }
     else if (arg == "-u" || arg == "--untrace")
     {
       i += 1;
@@ -449,6 +509,41 @@ parse_options(Options& options, int argc, char* argv[])
       check_solver(solver);
       options.cross_check = solver;
     }
+    else if (arg == "--vote")
+    {
+      record_args.push_back(arg);
+      i += 1;
+      check_next_arg(arg, i, size);
+      record_args.push_back(args[i]);
+      for (const auto& solver : split(args[i], ','))
+      {
+        MURXLA_EXIT_ERROR(!is_valid_solver_str(solver))
+            << "invalid argument " << solver << " to option '" << arg << "'";
+        check_solver(solver);
+        options.vote_solvers.push_back(solver);
+      }
+    }
+    else if (arg == "--perf-time")
+    {
+      record_args.push_back(arg);
+      i += 1;
+      check_next_arg(arg, i, size);
+      record_args.push_back(args[i]);
+      options.perf_time = std::atof(args[i].c_str());
+    }
+    else if (arg == "--perf-ratio")
+    {
+      record_args.push_back(arg);
+      i += 1;
+      check_next_arg(arg, i, size);
+      record_args.push_back(args[i]);
+      options.perf_ratio = std::atof(args[i].c_str());
+    }
+    else if (arg == "--cross-check-concurrent")
+    {
+      record_args.push_back(arg);
+      options.cross_check_concurrent = true;
+    }
     else if (arg == "-C" || arg == "--check")
     {
       record_args.push_back(arg);
@@ -507,6 +602,11 @@ parse_options(Options& options, int argc, char* argv[])
       options.solver = SOLVER_YICES;
       record_args.push_back(arg);
     }
+    else if (arg == "--mock")
+    {
+      options.solver = SOLVER_MOCK;
+      record_args.push_back(arg);
+    }
     else if (arg == "--smt2")
     {
       record_args.push_back(arg);
@@ -520,12 +620,29 @@ parse_options(Options& options, int argc, char* argv[])
       }
       options.solver = SOLVER_SMT2;
     }
+    else if (arg == "--smt2-pipeline")
+    {
+      options.smt2_pipeline = true;
+      record_args.push_back(arg);
+    }
     else if (arg == "-f" || arg == "--smt2-file")
     {
       i += 1;
       check_next_arg(arg, i, size);
       options.smt2_file_name = args[i];
     }
+    else if (arg == "--smt2-store")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.smt2_store_dir = args[i];
+    }
+    else if (arg == "--smt2-extract")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.smt2_extract_dir = args[i];
+    }
     else if (arg == "-o" || arg == "--cross-check-opts")
     {
       record_args.push_back(arg);
@@ -558,6 +675,39 @@ parse_options(Options& options, int argc, char* argv[])
     {
       g_errors_print_csv = true;
     }
+    else if (arg == "--stats-json")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.stats_json_file_name = args[i];
+    }
+    else if (arg == "--stats-file")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.stats_file_name = args[i];
+    }
+    else if (arg == "--cov-feedback")
+    {
+      options.cov_feedback = true;
+    }
+    else if (arg == "--cov-weights")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.cov_feedback          = true;
+      options.cov_weights_file_name = args[i];
+    }
+    else if (arg == "--corpus")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.corpus_dir = args[i];
+    }
+    else if (arg == "--mutate")
+    {
+      options.mutate = true;
+    }
     else if (arg == "-e" || arg == "--export-errors")
     {
       i += 1;
@@ -568,6 +718,22 @@ parse_options(Options& options, int argc, char* argv[])
     {
       options.solver_trace = true;
     }
+    else if (arg == "--replay-dir")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.replay_dir = args[i];
+    }
+    else if (arg == "-j" || arg == "--jobs")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      MURXLA_EXIT_ERROR(args[i].empty()
+                        || args[i].find_first_not_of("0123456789")
+                               != std::string::npos)
+          << "invalid argument to option '" << arg << "': " << args[i];
+      options.jobs = static_cast<uint32_t>(std::stoul(args[i]));
+    }
     else if (arg == "-m" || arg == "--max-runs")
     {
       i += 1;
@@ -724,6 +890,23 @@ parse_options(Options& options, int argc, char* argv[])
     options.check_solver_name = "";
   }
 
+  MURXLA_EXIT_ERROR(!options.replay_dir.empty()
+                    && (!options.untrace_file_name.empty() || options.dd))
+      << "option '--replay-dir' can not be combined with '--untrace' or "
+         "'--dd'";
+
+  MURXLA_EXIT_ERROR(!options.vote_solvers.empty()
+                    && !options.cross_check.empty())
+      << "options '--vote' and '--cross-check' are mutually exclusive";
+
+  MURXLA_EXIT_ERROR(options.mutate && options.corpus_dir.empty())
+      << "option '--mutate' requires '--corpus'";
+
+  MURXLA_EXIT_ERROR(!options.smt2_store_dir.empty()
+                    && (options.solver != SOLVER_SMT2
+                        || !options.solver_binary.empty()))
+      << "option '--smt2-store' requires '--smt2' without a solver binary";
+
   /* Use an instance of the same solver for checking unsat cores if not
    * otherwise specified. */
   if (options.check_solver && options.check_solver_name.empty())
@@ -746,12 +929,25 @@ parse_options(Options& options, int argc, char* argv[])
 int
 main(int argc, char* argv[])
 {
-  statistics::Statistics* stats = initialize_statistics();
   SolverOptions solver_options;
   Options options;
 
   parse_options(options, argc, argv);
 
+  /* One statistics shard per worker process that records statistics
+   * concurrently (see Murxla::replay_dir()), one per hardware thread by
+   * default. */
+  statistics::Statistics* stats = statistics::Statistics::create(std::max(
+      {1u, std::thread::hardware_concurrency(), options.jobs}));
+
+  if (!options.smt2_extract_dir.empty())
+  {
+    uint64_t n =
+        Smt2Store::extract(options.smt2_extract_dir, options.out_dir);
+    std::cout << "extracted " << n << " SMT2 files" << std::endl;
+    exit(0);
+  }
+
   bool is_untrace    = !options.untrace_file_name.empty();
   bool is_continuous = !options.is_seeded && !is_untrace;
   bool is_forked     = options.dd || is_continuous;
@@ -766,7 +962,8 @@ main(int argc, char* argv[])
 
   try
   {
-    Murxla murxla(stats, options, &solver_options, &g_errors, TMP_DIR);
+    Murxla murxla(
+        stats, options, &solver_options, &g_errors, &g_timeouts, TMP_DIR);
 
     if (options.print_fsm)
     {
@@ -774,7 +971,11 @@ main(int argc, char* argv[])
       exit(0);
     }
 
-    if (is_continuous)
+    if (!options.replay_dir.empty())
+    {
+      murxla.replay_dir(options.replay_dir, options.jobs);
+    }
+    else if (is_continuous)
     {
       set_sigint_handler_stats();
       murxla.test();
@@ -848,8 +1049,13 @@ main(int argc, char* argv[])
   {
     stats->print();
   }
+  if (!options.stats_json_file_name.empty())
+  {
+    std::ofstream o = open_output_file(options.stats_json_file_name, false);
+    o << std::setw(2) << stats->to_json() << std::endl;
+  }
 
-  MURXLA_EXIT_ERROR(munmap(stats, sizeof(Statistics)))
+  MURXLA_EXIT_ERROR(statistics::Statistics::destroy(stats))
       << "failed to unmap shared memory for statistics";
 
   if (std::filesystem::exists(TMP_DIR))
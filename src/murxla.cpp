@@ -10,25 +10,40 @@
 #include "murxla.hpp"
 
 #include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <nlohmann/json.hpp>
 #include <regex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
 
+#include "corpus.hpp"
+#include "coverage.hpp"
 #include "dd.hpp"
 #include "except.hpp"
 #include "fsm.hpp"
+#include "smt2_store.hpp"
 #include "solver/btor/btor_solver.hpp"
 #include "solver/bzla/bzla_solver.hpp"
 #include "solver/cvc5/cvc5_solver.hpp"
 #include "solver/meta/check_solver.hpp"
 #include "solver/meta/shadow_solver.hpp"
+#include "solver/mock/mock_solver.hpp"
 #include "solver/smt2/smt2_solver.hpp"
 #include "solver/solver_profile.hpp"
 #include "solver/yices/yices_solver.hpp"
@@ -137,6 +152,270 @@ error_diff(const std::string& e1, const std::string& e2)
   return static_cast<double>(diff) / static_cast<double>(len);
 }
 
+/**
+ * Map the exit status of a test run child process to a result.
+ */
+Result
+status_to_result(int32_t status)
+{
+  if (WIFEXITED(status))
+  {
+    switch (WEXITSTATUS(status))
+    {
+      case EXIT_OK: return RESULT_OK;
+      case EXIT_ERROR_CONFIG: return RESULT_ERROR_CONFIG;
+      case EXIT_ERROR_UNTRACE: return RESULT_ERROR_UNTRACE;
+      default: assert(WEXITSTATUS(status) == EXIT_ERROR); return RESULT_ERROR;
+    }
+  }
+  assert(WIFSIGNALED(status));
+  return RESULT_ERROR;
+}
+
+/**
+ * Read exactly 'size' bytes from file descriptor 'fd' into 'buf'.
+ * Returns false on EOF or error.
+ */
+bool
+read_fd(int32_t fd, void* buf, size_t size)
+{
+  char* p = static_cast<char*>(buf);
+  while (size > 0)
+  {
+    ssize_t n = read(fd, p, size);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+/**
+ * Write exactly 'size' bytes from 'buf' to file descriptor 'fd'.
+ * Returns false on error.
+ */
+bool
+write_fd(int32_t fd, const void* buf, size_t size)
+{
+  const char* p = static_cast<const char*>(buf);
+  while (size > 0)
+  {
+    ssize_t n = write(fd, p, size);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+/** Write a length-prefixed string to file descriptor 'fd'. */
+bool
+write_fd_str(int32_t fd, const std::string& s)
+{
+  uint32_t size = static_cast<uint32_t>(s.size());
+  return write_fd(fd, &size, sizeof(size)) && write_fd(fd, s.data(), size);
+}
+
+/** Read a length-prefixed string from file descriptor 'fd'. */
+bool
+read_fd_str(int32_t fd, std::string& s)
+{
+  uint32_t size;
+  if (!read_fd(fd, &size, sizeof(size))) return false;
+  s.resize(size);
+  return read_fd(fd, s.data(), size);
+}
+
+/**
+ * Create a pipe for capturing the stdout or stderr output of a test run
+ * process.  The read end is non-blocking.
+ */
+void
+create_output_pipe(int32_t fds[2])
+{
+  MURXLA_CHECK(pipe(fds) == 0) << "creating output pipe failed";
+  fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+}
+
+/**
+ * Read all currently available data from the non-blocking file descriptor
+ * 'fd' and append it to 'buf'.
+ * Returns false if the write end of the pipe was closed.
+ */
+bool
+read_available(int32_t fd, std::string& buf)
+{
+  char data[4096];
+  while (true)
+  {
+    ssize_t n = read(fd, data, sizeof(data));
+    if (n > 0)
+    {
+      buf.append(data, static_cast<size_t>(n));
+    }
+    else if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    else
+    {
+      return n < 0 && errno == EAGAIN;
+    }
+  }
+}
+
+/** The outcome of collecting the output of a test run process. */
+enum class CollectResult
+{
+  DONE,     /* Process terminated (or 'fd_sync' became readable). */
+  TIMEOUT,  /* Time limit exceeded. */
+  ABORTED,  /* Output check requested to abort the test run. */
+};
+
+/**
+ * Collect the stdout and stderr output of a test run process in memory.
+ *
+ * If 'fd_sync' is given (>= 0), output is collected until 'fd_sync' becomes
+ * readable.  Else, output is collected until test run process 'pid' has
+ * terminated, in which case it is also reaped and its exit status is stored
+ * in 'status'.
+ *
+ * pid    : The pid of the test run process, only used if fd_sync < 0.
+ * fd_sync: The file descriptor to wait for, -1 if not used.
+ * fd_out : The read end of the pipe the process writes its stdout output to.
+ * fd_err : The read end of the pipe the process writes its stderr output to.
+ * out    : The buffer to append stdout output to.
+ * err    : The buffer to append stderr output to.
+ * time   : The time limit in seconds, 0 for no limit.
+ * check  : If given, called whenever new output was read, returns false if
+ *          the test run should be aborted.
+ * status : The exit status of the process, only set if fd_sync < 0.
+ */
+CollectResult
+collect_output(pid_t pid,
+               int32_t fd_sync,
+               int32_t fd_out,
+               int32_t fd_err,
+               std::string& out,
+               std::string& err,
+               double time,
+               const Murxla::OutputCheck& check,
+               int32_t& status)
+{
+  auto start           = std::chrono::steady_clock::now();
+  struct pollfd fds[3] = {
+      {fd_out, POLLIN, 0}, {fd_err, POLLIN, 0}, {fd_sync, POLLIN, 0}};
+  std::string* bufs[2] = {&out, &err};
+
+  while (true)
+  {
+    /* Poll in slices to detect processes that terminated while the pipes are
+     * still held open by one of their children (e.g., online solvers). */
+    int32_t timeout = 50;
+    if (time > 0)
+    {
+      double remaining =
+          time
+          - std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                          - start)
+                .count();
+      if (remaining <= 0) return CollectResult::TIMEOUT;
+      timeout = std::min(timeout, static_cast<int32_t>(remaining * 1000) + 1);
+    }
+
+    int32_t n = poll(fds, 3, timeout);
+    if (n < 0 && errno != EINTR) return CollectResult::TIMEOUT;
+
+    bool has_output = false;
+    for (size_t i = 0; i < 2; ++i)
+    {
+      if (fds[i].fd >= 0 && fds[i].revents)
+      {
+        size_t size = bufs[i]->size();
+        if (!read_available(fds[i].fd, *bufs[i])) fds[i].fd = -1;
+        has_output = has_output || bufs[i]->size() > size;
+      }
+    }
+    if (has_output && check && !check(out, err))
+    {
+      return CollectResult::ABORTED;
+    }
+
+    if (fd_sync >= 0)
+    {
+      if (fds[2].revents) break;
+    }
+    else if (fds[0].fd < 0 && fds[1].fd < 0)
+    {
+      waitpid(pid, &status, 0);
+      return CollectResult::DONE;
+    }
+    else if (n == 0 && waitpid(pid, &status, WNOHANG) == pid)
+    {
+      break;
+    }
+  }
+
+  /* Read remaining output written before the process terminated. */
+  if (fds[0].fd >= 0) read_available(fd_out, out);
+  if (fds[1].fd >= 0) read_available(fd_err, err);
+  return CollectResult::DONE;
+}
+
+/**
+ * Execute 'fun' in a forked test run process and exit with the exit code
+ * corresponding to its outcome.
+ */
+[[noreturn]] void
+run_forked_and_exit(const std::function<void()>& fun)
+{
+  try
+  {
+    fun();
+  }
+  catch (MurxlaConfigException& e)
+  {
+    MURXLA_EXIT_ERROR_CONFIG_FORK(true, true) << e.get_msg();
+  }
+  catch (MurxlaUntraceException& e)
+  {
+    MURXLA_EXIT_ERROR_UNTRACE_FORK(true, true) << e.get_msg();
+  }
+  catch (MurxlaException& e)
+  {
+    MURXLA_EXIT_ERROR_FORK(true, true) << e.get_msg();
+  }
+  exit(EXIT_OK);
+}
+
+/**
+ * Get the options of a 'set-murxla-options' line as a set of options with
+ * their arguments, which is independent of the order of the options.
+ */
+std::set<std::string>
+get_murxla_options(const std::string& line)
+{
+  std::set<std::string> res;
+  std::string opt;
+  for (const auto& token : split(line, ' '))
+  {
+    if (token.empty() || token == "set-murxla-options") continue;
+    if (token[0] == '-')
+    {
+      if (!opt.empty()) res.insert(opt);
+      opt = token;
+    }
+    else
+    {
+      opt += " " + token;
+    }
+  }
+  if (!opt.empty()) res.insert(opt);
+  return res;
+}
+
 }  // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -145,15 +424,18 @@ Murxla::Murxla(statistics::Statistics* stats,
                const Options& options,
                SolverOptions* solver_options,
                ErrorMap* error_map,
+               ErrorMap* timeout_map,
                const std::string& tmp_dir)
     : d_options(options),
       d_solver_options(solver_options),
       d_tmp_dir(tmp_dir),
       d_stats(stats),
-      d_errors(error_map)
+      d_errors(error_map),
+      d_timeouts(timeout_map)
 {
   assert(stats);
   assert(solver_options);
+  d_dummy_stats = statistics::Statistics::create(1);
   load_solver_profile();
 
   if (!d_options.export_errors_filename.empty())
@@ -162,8 +444,38 @@ Murxla::Murxla(statistics::Statistics* stats,
                            d_exclude_errors.begin(),
                            d_exclude_errors.end());
   }
+
+  if (d_options.solver == SOLVER_SMT2 && !d_options.solver_binary.empty())
+  {
+    d_smt2_pool.reset(
+        new smt2::Smt2OnlineSolverPool(d_options.solver_binary));
+  }
+
+  if (!d_options.smt2_store_dir.empty())
+  {
+    d_smt2_store.reset(new Smt2Store(d_options.smt2_store_dir));
+  }
+
+  if (d_options.cov_feedback)
+  {
+    MURXLA_EXIT_ERROR(!coverage::is_available())
+        << "coverage feedback requires a solver built with "
+           "-fsanitize-coverage=trace-pc-guard";
+    d_cov_feedback.reset(new coverage::Feedback(d_stats));
+    if (!d_options.cov_weights_file_name.empty())
+    {
+      d_cov_feedback->load(d_options.cov_weights_file_name);
+    }
+  }
+
+  if (!d_options.corpus_dir.empty())
+  {
+    d_corpus.reset(new Corpus(d_options.corpus_dir));
+  }
 }
 
+Murxla::~Murxla() { statistics::Statistics::destroy(d_dummy_stats); }
+
 Result
 Murxla::run(uint64_t seed,
             double time,
@@ -221,7 +533,18 @@ Murxla::run(uint64_t seed,
       copy_to   = api_trace_file_name;
     }
 
-    if (copy_from != copy_to)
+    /* In online mode, the SMT2 file of an error is written to its error
+     * directory as usual. */
+    if (d_smt2_store && d_options.solver_binary.empty()
+        && copy_from == get_tmp_file_path(SMT2_FILE, d_tmp_dir))
+    {
+      std::ifstream in = open_input_file(copy_from, false);
+      std::stringstream ss;
+      ss << in.rdbuf();
+      d_smt2_store->add(std::filesystem::path(copy_to).filename().string(),
+                        ss.str());
+    }
+    else if (copy_from != copy_to)
     {
       assert(std::filesystem::exists(copy_from));
 
@@ -277,11 +600,41 @@ Murxla::test()
 
   std::string err_file_name = get_tmp_file_path("tmp.err", d_tmp_dir);
   Terminal term;
+  double stats_file_time = start_time;
+  double cov_save_time   = start_time;
+
+  /* Do not store traces that we already hold from previous runs. */
+  if (!d_options.out_dir.empty()
+      && std::filesystem::is_directory(d_options.out_dir))
+  {
+    for (const auto& p :
+         std::filesystem::recursive_directory_iterator(d_options.out_dir))
+    {
+      if (p.is_regular_file() && p.path().extension() == ".trace")
+      {
+        (void) find_duplicate_trace(p.path().string());
+      }
+    }
+  }
 
   do
   {
     double cur_time = get_cur_wall_time();
 
+    if (!d_options.stats_file_name.empty()
+        && cur_time - stats_file_time >= MURXLA_STATS_FILE_INTERVAL)
+    {
+      write_stats_file(num_runs, num_timeouts, cur_time - start_time);
+      stats_file_time = cur_time;
+    }
+
+    if (d_cov_feedback && !d_options.cov_weights_file_name.empty()
+        && cur_time - cov_save_time >= MURXLA_COV_SAVE_INTERVAL)
+    {
+      d_cov_feedback->save(d_options.cov_weights_file_name);
+      cov_save_time = cur_time;
+    }
+
     uint64_t seed = sg.next();
 
     if (num_printed_lines % 100 == 0)
@@ -294,6 +647,14 @@ Murxla::test()
       std::cout << " " << std::setw(5) << "unknw";
       std::cout << " " << std::setw(5) << "to";
       std::cout << " " << std::setw(5) << "err";
+      if (d_cov_feedback)
+      {
+        std::cout << " " << std::setw(7) << "edges";
+      }
+      if (d_corpus)
+      {
+        std::cout << " " << std::setw(6) << "corpus";
+      }
 
       std::cout << std::endl;
       ++num_printed_lines;
@@ -303,13 +664,22 @@ Murxla::test()
     std::cout << " " << std::setw(5) << num_runs;
     std::cout << " " << std::setw(8) << std::setprecision(2) << std::fixed;
     std::cout << num_runs / (cur_time - start_time);
-    std::cout << " " << std::setw(5) << d_stats->d_results[Solver::Result::SAT];
     std::cout << " " << std::setw(5)
-              << d_stats->d_results[Solver::Result::UNSAT];
+              << d_stats->get_num_results(Solver::Result::SAT);
+    std::cout << " " << std::setw(5)
+              << d_stats->get_num_results(Solver::Result::UNSAT);
     std::cout << " " << std::setw(5)
-              << d_stats->d_results[Solver::Result::UNKNOWN];
+              << d_stats->get_num_results(Solver::Result::UNKNOWN);
     std::cout << " " << std::setw(5) << num_timeouts;
     std::cout << " " << std::setw(5) << d_errors->size();
+    if (d_cov_feedback)
+    {
+      std::cout << " " << std::setw(7) << d_cov_feedback->get_num_edges();
+    }
+    if (d_corpus)
+    {
+      std::cout << " " << std::setw(6) << d_corpus->size();
+    }
     std::cout << std::flush;
     num_runs++;
 
@@ -326,19 +696,71 @@ Murxla::test()
     std::string api_trace_file_name = get_api_trace_file_name(seed);
     bool smt2_offline =
         (d_options.solver == SOLVER_SMT2 && d_options.solver_binary.empty());
+
+    /* Resume from a random prefix of a corpus trace. */
+    std::string untrace_file_name = d_options.untrace_file_name;
+    d_resume                      = false;
+    if (d_options.mutate && !d_corpus->empty())
+    {
+      RNGenerator rng(seed);
+      if (rng.pick_with_prob(MURXLA_MUTATE_PROB))
+      {
+        untrace_file_name = get_tmp_file_path(CORPUS_PREFIX, d_tmp_dir);
+        d_resume_seed = d_corpus->pick_prefix(rng, untrace_file_name).d_seed;
+        d_resume      = true;
+      }
+    }
+
+    std::vector<Solver::Result> results = {
+        Solver::Result::SAT, Solver::Result::UNSAT, Solver::Result::UNKNOWN};
+    std::vector<uint64_t> num_results;
+    for (const auto& r : results)
+    {
+      num_results.push_back(d_stats->get_num_results(r));
+    }
+
+    if (d_cov_feedback)
+    {
+      coverage::reset();
+    }
     Result res =
         run(seed,
             d_options.time,
             out_file_name,
             err_file_name,
-            api_trace_file_name,
-            d_options.untrace_file_name,
+            d_corpus ? DEVNULL : api_trace_file_name,
+            untrace_file_name,
             true,
             true,
-            // for the SMT2 offline mode we want to store all SMT2 files
-            smt2_offline ? TO_FILE : NONE);
+            // for the SMT2 offline mode we want to store all SMT2 files, the
+            // corpus needs the API trace of every run
+            smt2_offline || d_corpus ? TO_FILE : NONE);
+    uint64_t num_new_edges = 0;
+    if (d_cov_feedback)
+    {
+      num_new_edges = d_cov_feedback->collect();
+    }
+
+    /* Keep the trace of the run if it was interesting. */
+    if (d_corpus && res == RESULT_OK)
+    {
+      std::vector<std::string> run_results;
+      for (size_t i = 0, n = results.size(); i < n; ++i)
+      {
+        if (d_stats->get_num_results(results[i]) > num_results[i])
+        {
+          std::stringstream ss;
+          ss << results[i];
+          run_results.push_back(ss.str());
+        }
+      }
+      d_corpus->add(d_resume ? d_resume_seed : seed,
+                    get_tmp_file_path(API_TRACE, d_tmp_dir),
+                    run_results,
+                    num_new_edges > 0);
+    }
 
-    std::string errmsg, errmsg_filtered;
+    std::string errmsg, errmsg_filtered, held_trace_name;
     ErrorKind errkind = ErrorKind::ERROR;
     /* report status */
     if (res == RESULT_OK)
@@ -381,6 +803,11 @@ Murxla::test()
           MURXLA_CHECK_TRACE(false) << errmsg_filtered << " " << d_error_msg;
         }
       }
+      else if (res == RESULT_TIMEOUT)
+      {
+        std::tie(errkind, errmsg_filtered, error_id, error_nduplicates) =
+            add_timeout(seed);
+      }
 
       std::stringstream info;
       info << " [";
@@ -403,7 +830,7 @@ Murxla::test()
         case RESULT_ERROR_CONFIG: info << term.red() << "config error"; break;
         case RESULT_ERROR_UNTRACE: info << term.red() << "untrace error"; break;
         case RESULT_TIMEOUT:
-          info << term.blue() << "timeout";
+          info << term.blue() << "timeout:" << error_id;
           ++num_timeouts;
           break;
         default: assert(res == RESULT_UNKNOWN); info << "unknown";
@@ -411,9 +838,12 @@ Murxla::test()
       info << term.defaultcolor() << "]";
 
       std::cout << info.str() << std::flush;
-      if (res == RESULT_ERROR && errkind != ErrorKind::FILTER)
+      if ((res == RESULT_ERROR && errkind != ErrorKind::FILTER)
+          || (res == RESULT_TIMEOUT && errkind == ErrorKind::ERROR))
       {
-        std::cout << " ";
+        /* Flush before replaying, else the timeout process of the replay
+         * inherits and flushes the buffered output, too. */
+        std::cout << " " << std::flush;
       }
       else
       {
@@ -442,9 +872,17 @@ Murxla::test()
                                      out_file_name,
                                      err_file_name,
                                      api_trace_file_name,
-                                     d_options.untrace_file_name);
+                                     untrace_file_name,
+                                     held_trace_name);
 
-          std::cout << api_trace_file_name << std::endl;
+          if (held_trace_name.empty())
+          {
+            std::cout << api_trace_file_name << std::endl;
+          }
+          else
+          {
+            std::cout << "same trace as " << held_trace_name << std::endl;
+          }
 
           // Note: This may happen in few cases where the replay runs into a
           // timeout, but the original run does not.
@@ -454,8 +892,48 @@ Murxla::test()
               << res_replay << ".";
         }
       }
+      /* Replay and trace on new timeout with the same time limit.  The trace
+       * ends with the action the solver hangs in. */
+      else if (res == RESULT_TIMEOUT && errkind == ErrorKind::ERROR)
+      {
+        if (smt2_offline)
+        {
+          std::cout << get_smt2_file_name(seed, api_trace_file_name)
+                    << std::endl;
+        }
+        else
+        {
+          api_trace_file_name = get_api_trace_file_name(seed, error_id, true);
+          Result res_replay   = run(seed,
+                                  d_options.time,
+                                  out_file_name,
+                                  err_file_name,
+                                  api_trace_file_name,
+                                  untrace_file_name,
+                                  true,
+                                  false,
+                                  TO_FILE);
+
+          held_trace_name = find_duplicate_trace(api_trace_file_name);
+          if (held_trace_name.empty())
+          {
+            std::cout << api_trace_file_name << std::endl;
+          }
+          else
+          {
+            std::filesystem::remove(api_trace_file_name);
+            std::cout << "same trace as " << held_trace_name << std::endl;
+          }
+
+          MURXLA_WARN(res != res_replay)
+              << "Replay did not return the same result as original run. "
+              << "Original run returned " << res << ", but replay returned "
+              << res_replay << ".";
+        }
+      }
       /* Print new error message after it was found. */
-      if (res == RESULT_ERROR && errkind == ErrorKind::ERROR)
+      if ((res == RESULT_ERROR || res == RESULT_TIMEOUT)
+          && errkind == ErrorKind::ERROR)
       {
         std::cout << std::endl;
         std::cout << rstrip(errmsg_filtered) << "\n" << std::endl;
@@ -470,7 +948,346 @@ Murxla::test()
         os << errmsg_filtered << "\n";
       }
     }
+
+    /* Update the coverage weights after replaying, the replay must use the
+     * same weights as the original run. */
+    if (d_cov_feedback)
+    {
+      d_cov_feedback->update();
+    }
   } while (d_options.max_runs == 0 || num_runs < d_options.max_runs);
+
+  if (!d_options.stats_file_name.empty())
+  {
+    write_stats_file(num_runs, num_timeouts, get_cur_wall_time() - start_time);
+  }
+  if (d_cov_feedback && !d_options.cov_weights_file_name.empty())
+  {
+    d_cov_feedback->save(d_options.cov_weights_file_name);
+  }
+}
+
+void
+Murxla::replay_dir(const std::string& dir, uint32_t num_jobs)
+{
+  MURXLA_EXIT_ERROR(!std::filesystem::is_directory(dir))
+      << "'" << dir << "' is not a directory";
+
+  std::vector<std::string> traces;
+  for (const auto& p : std::filesystem::recursive_directory_iterator(dir))
+  {
+    if (p.is_regular_file() && p.path().extension() == ".trace")
+    {
+      traces.push_back(p.path().string());
+    }
+  }
+  std::sort(traces.begin(), traces.end());
+  MURXLA_EXIT_ERROR(traces.empty()) << "no trace files in '" << dir << "'";
+
+  /* Replay only one of each set of traces with the same canonical form. */
+  size_t num_traces = traces.size();
+  traces.erase(std::remove_if(traces.begin(),
+                              traces.end(),
+                              [this](const std::string& trace) {
+                                return !find_duplicate_trace(trace).empty();
+                              }),
+               traces.end());
+
+  if (num_jobs == 0)
+  {
+    num_jobs = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_jobs = static_cast<uint32_t>(
+      std::min(static_cast<size_t>(num_jobs), traces.size()));
+
+  /* The index of the next trace to replay, claimed by the workers. */
+  void* mem = mmap(nullptr,
+                   sizeof(std::atomic<uint64_t>),
+                   PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS,
+                   -1,
+                   0);
+  MURXLA_CHECK(mem != MAP_FAILED) << "unable to allocate shared memory";
+  std::atomic<uint64_t>* next = new (mem) std::atomic<uint64_t>(0);
+
+  double start_time = get_cur_wall_time();
+  std::vector<pid_t> workers;
+  for (uint32_t i = 0; i < num_jobs; ++i)
+  {
+    pid_t pid = fork();
+    MURXLA_CHECK(pid >= 0) << "forking replay worker failed";
+    if (pid == 0)
+    {
+      replay_dir_worker(i, traces, *next);
+      exit(EXIT_OK);
+    }
+    workers.push_back(pid);
+  }
+  /* Workers only terminate abnormally if Murxla itself fails, the test runs
+   * are forked off the workers. */
+  std::vector<std::string> worker_errors;
+  for (uint32_t i = 0; i < num_jobs; ++i)
+  {
+    int32_t status;
+    waitpid(workers[i], &status, 0);
+    std::stringstream ss;
+    if (WIFSIGNALED(status))
+    {
+      ss << "worker " << i << " terminated by signal " << WTERMSIG(status);
+    }
+    else if (WIFEXITED(status) && WEXITSTATUS(status) != EXIT_OK)
+    {
+      ss << "worker " << i << " exited with exit code "
+         << WEXITSTATUS(status);
+    }
+    if (!ss.str().empty()) worker_errors.push_back(ss.str());
+  }
+  munmap(mem, sizeof(std::atomic<uint64_t>));
+  double elapsed = get_cur_wall_time() - start_time;
+
+  /* Collect the results of all workers. */
+  static const std::vector<std::string> kinds = {
+      "fixed", "same error", "different error", "error", "timeout", "invalid"};
+  std::vector<std::vector<std::pair<std::string, std::string>>> results(
+      kinds.size());
+  std::unordered_set<std::string> replayed;
+  for (uint32_t i = 0; i < num_jobs; ++i)
+  {
+    std::string file_name =
+        get_tmp_file_path("replay-" + std::to_string(i) + ".res", d_tmp_dir);
+    std::ifstream in = open_input_file(file_name, false);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      /* <kind> <trace>\t<error> */
+      size_t sp = line.find(' '), tab = line.find('\t');
+      if (sp == std::string::npos || tab == std::string::npos) continue;
+      size_t kind = std::stoul(line.substr(0, sp));
+      results.at(kind).emplace_back(line.substr(sp + 1, tab - sp - 1),
+                                    line.substr(tab + 1));
+      replayed.insert(results.at(kind).back().first);
+    }
+  }
+
+  std::cout << std::endl;
+  std::cout << "Replayed " << replayed.size() << " of " << traces.size()
+            << " traces in " << std::fixed << std::setprecision(2) << elapsed
+            << "s with " << num_jobs << " workers:" << std::endl;
+  std::cout << "  " << std::left << std::setw(16) << "duplicate" << std::right
+            << std::setw(6) << num_traces - traces.size() << std::endl;
+  for (size_t i = 0; i < kinds.size(); ++i)
+  {
+    std::cout << "  " << std::left << std::setw(16) << kinds[i] << std::right
+              << std::setw(6) << results[i].size() << std::endl;
+  }
+  /* List the traces that need attention. */
+  for (size_t i = 2; i < kinds.size(); ++i)
+  {
+    if (results[i].empty()) continue;
+    std::sort(results[i].begin(), results[i].end());
+    std::cout << std::endl << kinds[i] << ":" << std::endl;
+    for (const auto& [trace, err] : results[i])
+    {
+      std::cout << "  " << trace;
+      if (!err.empty())
+      {
+        std::cout << ": " << err;
+      }
+      std::cout << std::endl;
+    }
+  }
+  /* Traces claimed by a worker that terminated abnormally are missing. */
+  if (!worker_errors.empty())
+  {
+    std::cout << std::endl << "abnormal worker exit:" << std::endl;
+    for (const auto& err : worker_errors)
+    {
+      std::cout << "  " << err << std::endl;
+    }
+    std::cout << std::endl << "not replayed:" << std::endl;
+    for (const auto& trace : traces)
+    {
+      if (replayed.find(trace) != replayed.end()) continue;
+      std::cout << "  " << trace << std::endl;
+    }
+  }
+}
+
+void
+Murxla::replay_dir_worker(uint32_t worker,
+                          const std::vector<std::string>& traces,
+                          std::atomic<uint64_t>& next)
+{
+  std::string res_file_name = get_tmp_file_path(
+      "replay-" + std::to_string(worker) + ".res", d_tmp_dir);
+  std::ofstream res_file = open_output_file(res_file_name, true);
+
+  /* Workers record the statistics of their replays concurrently, each into
+   * its own shard. */
+  statistics::Statistics::set_worker(worker);
+
+  /* Test runs write to fixed temp file names, each worker needs its own
+   * temp directory. */
+  d_tmp_dir = prepend_path(d_tmp_dir, "worker-" + std::to_string(worker));
+  std::filesystem::create_directories(d_tmp_dir);
+  std::string out_file_name = get_tmp_file_path("replay.out", d_tmp_dir);
+  std::string err_file_name = get_tmp_file_path("replay.err", d_tmp_dir);
+
+  /* Traces are replayed with the options given on the command line, traces
+   * that were recorded with different options (see Options::cmd_line_trace)
+   * would be replayed in a different configuration. */
+  std::set<std::string> options = get_murxla_options(d_options.cmd_line_trace);
+
+  Terminal term;
+  for (uint64_t i = next++; i < traces.size(); i = next++)
+  {
+    const std::string& trace = traces[i];
+    ReplayKind kind;
+    std::string err_line;
+
+    std::string header;
+    {
+      std::ifstream in = open_input_file(trace, true);
+      std::getline(in, header);
+    }
+    if (header.rfind("set-murxla-options", 0) == 0
+        && get_murxla_options(header) != options)
+    {
+      kind     = ReplayKind::INVALID;
+      err_line = "recorded with different options: " + header;
+    }
+    else
+    {
+      std::filesystem::remove(err_file_name);
+      Result res = run(0,
+                       d_options.time,
+                       out_file_name,
+                       err_file_name,
+                       DEVNULL,
+                       trace,
+                       true,
+                       true,
+                       NONE);
+
+      std::string err;
+      if (std::filesystem::exists(err_file_name))
+      {
+        std::ifstream errs = open_input_file(err_file_name, true);
+        std::stringstream ss;
+        ss << errs.rdbuf();
+        err = ss.str();
+      }
+      if (res == RESULT_ERROR_UNTRACE || res == RESULT_ERROR_CONFIG)
+      {
+        err += d_error_msg;
+      }
+      kind = classify_replay(trace, res, err);
+
+      /* The first line of the error summarizes the new error. */
+      if (kind != ReplayKind::FIXED && kind != ReplayKind::SAME_ERROR)
+      {
+        std::stringstream ss(filter_error(err));
+        std::getline(ss, err_line);
+      }
+    }
+    res_file << static_cast<size_t>(kind) << " " << trace << "\t" << err_line
+             << std::endl;
+
+    std::stringstream info;
+    switch (kind)
+    {
+      case ReplayKind::FIXED: info << term.green() << "fixed"; break;
+      case ReplayKind::SAME_ERROR: info << term.gray() << "same error"; break;
+      case ReplayKind::DIFFERENT_ERROR:
+        info << term.red() << "different error";
+        break;
+      case ReplayKind::ERROR: info << term.red() << "error"; break;
+      case ReplayKind::TIMEOUT: info << term.blue() << "timeout"; break;
+      default: assert(kind == ReplayKind::INVALID); info << "invalid";
+    }
+    info << term.defaultcolor() << " " << trace << "\n";
+    /* Write each line at once, workers share stdout. */
+    std::cout << info.str() << std::flush;
+  }
+}
+
+Murxla::ReplayKind
+Murxla::classify_replay(const std::string& trace_file_name,
+                        Result res,
+                        const std::string& err)
+{
+  switch (res)
+  {
+    case RESULT_OK:
+    case RESULT_UNKNOWN: return ReplayKind::FIXED;
+    case RESULT_TIMEOUT: return ReplayKind::TIMEOUT;
+    case RESULT_ERROR_CONFIG:
+    case RESULT_ERROR_UNTRACE: return ReplayKind::INVALID;
+    default: assert(res == RESULT_ERROR);
+  }
+
+  std::filesystem::path error_file =
+      std::filesystem::path(trace_file_name).parent_path() / "error.txt";
+  if (!std::filesystem::exists(error_file))
+  {
+    return ReplayKind::ERROR;
+  }
+  std::ifstream in = open_input_file(error_file.string(), true);
+  std::stringstream expected;
+  expected << in.rdbuf();
+
+  /* Errors are classified as the same error if they differ in at most 5% of
+   * characters, see add_error(). */
+  std::string err_norm = normalize_asan_error(filter_error(err));
+  std::string exp_norm = normalize_asan_error(filter_error(expected.str()));
+  return error_diff(rstrip(err_norm), rstrip(exp_norm)) <= 0.05
+             ? ReplayKind::SAME_ERROR
+             : ReplayKind::DIFFERENT_ERROR;
+}
+
+void
+Murxla::write_stats_file(uint32_t num_runs,
+                         uint64_t num_timeouts,
+                         double elapsed) const
+{
+  nlohmann::json j    = d_stats->to_json();
+  j["runs"]            = num_runs;
+  j["elapsed"]         = elapsed;
+  j["runs_per_second"] = elapsed > 0 ? num_runs / elapsed : 0;
+  j["timeouts"]        = num_timeouts;
+
+  auto errors_to_json = [](const ErrorMap& errors) {
+    nlohmann::json res = nlohmann::json::array();
+    for (const auto& [err, info] : errors)
+    {
+      res.push_back({{"id", info.id},
+                     {"message", info.errmsg},
+                     {"count", info.seeds.size()}});
+    }
+    return res;
+  };
+  j["errors"]        = errors_to_json(*d_errors);
+  j["timeout_kinds"] = errors_to_json(*d_timeouts);
+
+  /* Resource usage of all terminated and waited-for test run processes. */
+  struct rusage usage;
+  if (getrusage(RUSAGE_CHILDREN, &usage) == 0)
+  {
+    auto to_seconds = [](const struct timeval& tv) {
+      return static_cast<double>(tv.tv_sec)
+             + static_cast<double>(tv.tv_usec) / 1000000.0;
+    };
+    j["children"] = {{"user_time", to_seconds(usage.ru_utime)},
+                     {"system_time", to_seconds(usage.ru_stime)},
+                     {"max_rss_kb", usage.ru_maxrss}};
+  }
+
+  /* Write to temp file first, the snapshot is replaced atomically. */
+  std::string tmp_file_name = d_options.stats_file_name + ".tmp";
+  std::ofstream out_file    = open_output_file(tmp_file_name, false);
+  out_file << std::setw(2) << j << std::endl;
+  out_file.close();
+  std::filesystem::rename(tmp_file_name, d_options.stats_file_name);
 }
 
 Result
@@ -478,7 +1295,8 @@ Murxla::replay(uint64_t seed,
                const std::string& out_file_name,
                const std::string& err_file_name,
                const std::string& api_trace_file_name,
-               const std::string& untrace_file_name)
+               const std::string& untrace_file_name,
+               std::string& held_trace_name)
 {
   Result res = run(seed,
                    0,
@@ -490,13 +1308,37 @@ Murxla::replay(uint64_t seed,
                    false,
                    TO_FILE);
 
+  held_trace_name = find_duplicate_trace(api_trace_file_name);
+  if (!held_trace_name.empty())
+  {
+    std::filesystem::remove(api_trace_file_name);
+    return res;
+  }
+
   if (d_options.dd)
   {
+    /* The replayed trace is complete, do not resume when minimizing. */
+    bool resume = d_resume;
+    d_resume    = false;
     DD(this, seed).run(api_trace_file_name, d_options.dd_trace_file_name);
+    d_resume = resume;
   }
   return res;
 }
 
+std::string
+Murxla::find_duplicate_trace(const std::string& trace_file_name)
+{
+  if (trace_file_name == DEVNULL || !std::filesystem::exists(trace_file_name))
+  {
+    return "";
+  }
+  auto [it, inserted] = d_trace_hashes.emplace(
+      canonical_trace_hash(trace_file_name), trace_file_name);
+  if (inserted || it->second == trace_file_name) return "";
+  return it->second;
+}
+
 Solver*
 Murxla::new_solver(SolverSeedGenerator& sng,
                    const SolverKind& solver_kind,
@@ -526,9 +1368,18 @@ Murxla::new_solver(SolverSeedGenerator& sng,
     return new yices::YicesSolver(sng);
 #endif
   }
+  else if (solver_kind == SOLVER_MOCK)
+  {
+    return new mock::MockSolver(sng);
+  }
   else if (solver_kind == SOLVER_SMT2)
   {
-    return new smt2::Smt2Solver(sng, smt2_out, d_options.solver_binary);
+    return new smt2::Smt2Solver(sng,
+                                smt2_out,
+                                d_options.solver_binary,
+                                d_options.smt2_pipeline,
+                                d_options.solver_trace,
+                                d_smt2_pool.get());
   }
   MURXLA_CHECK(true) << "no solver created";
   return nullptr;
@@ -538,23 +1389,51 @@ Solver*
 Murxla::create_solver(SolverSeedGenerator& sng, std::ostream& smt2_out) const
 {
   Solver* solver = new_solver(sng, d_options.solver, smt2_out);
+  std::vector<SolverKind> solver_kinds = {d_options.solver};
 
   /* If unsat core checking is enabled wrap solver with a CheckSolver. */
   if (d_options.check_solver)
   {
     Solver* reference_solver = new_solver(sng, d_options.check_solver_name);
     solver                   = new CheckSolver(sng, solver, reference_solver);
+    solver_kinds.push_back(d_options.check_solver_name);
   }
 
   if (!d_options.cross_check.empty())
   {
     Solver* reference_solver = new_solver(sng, d_options.cross_check);
-    solver = new shadow::ShadowSolver(sng, solver, reference_solver);
+    solver_kinds.push_back(d_options.cross_check);
+    bool concurrent =
+        d_options.cross_check_concurrent && is_concurrent(solver_kinds);
+    solver = new shadow::ShadowSolver(
+        sng, {solver, reference_solver}, concurrent, d_options.perf_ratio);
+  }
+
+  if (!d_options.vote_solvers.empty())
+  {
+    std::vector<Solver*> solvers = {solver};
+    for (const auto& solver_kind : d_options.vote_solvers)
+    {
+      solvers.push_back(new_solver(sng, solver_kind));
+      solver_kinds.push_back(solver_kind);
+    }
+    solver = new shadow::ShadowSolver(
+        sng, solvers, is_concurrent(solver_kinds), d_options.perf_ratio);
   }
 
   return solver;
 }
 
+bool
+Murxla::is_concurrent(const std::vector<SolverKind>& solver_kinds) const
+{
+  /* Native solver traces must not interleave, and Yices instances share
+   * global state, a single Yices instance is fine. */
+  return !d_options.solver_trace
+         && std::count(solver_kinds.begin(), solver_kinds.end(), SOLVER_YICES)
+                <= 1;
+}
+
 FSM
 Murxla::create_fsm(RNGenerator& rng,
                    SolverSeedGenerator& sng,
@@ -563,10 +1442,6 @@ Murxla::create_fsm(RNGenerator& rng,
                    bool record_stats,
                    bool in_untrace_replay_mode) const
 {
-  /* Dummy statistics object for the cases were we don't want to record
-   * statistics (replay, dd). */
-  statistics::Statistics dummy_stats;
-
   if (!d_options.cmd_line_trace.empty())
   {
     trace << d_options.cmd_line_trace << std::endl;
@@ -580,10 +1455,11 @@ Murxla::create_fsm(RNGenerator& rng,
              *d_solver_options,
              d_options.arith_linear,
              d_options.simple_symbols,
+             d_options.perf_time,
              d_options.smtlib_compliant,
              d_options.fuzz_options,
              d_options.fuzz_options_filter,
-             record_stats ? d_stats : &dummy_stats,
+             record_stats ? d_stats : d_dummy_stats,
              d_options.enabled_theories,
              d_options.disabled_theories,
              d_options.solver_options,
@@ -665,17 +1541,21 @@ Murxla::run_aux(uint64_t seed,
   /* The global random number generator. Used everywhere, except for in the
    * solvers, which maintain their own RNG, seed with seeds from the solver
    * seed generator. This guarantees that runs can be reproduced even when
-   * solvers use the RNG in their API wrapper functions. */
-  RNGenerator rng(seed);
+   * solvers use the RNG in their API wrapper functions.
+   * When resuming from a corpus trace prefix, the FSM is configured with the
+   * seed of the corpus trace, which enables the same theories. */
+  RNGenerator rng(d_resume ? d_resume_seed : seed);
   /* The solver seed generator.  Responsible for generating seeds to be used to
    * seed the random generator of the solver. */
-  SolverSeedGenerator sng(seed);
+  SolverSeedGenerator sng(d_resume ? d_resume_seed : seed);
 
   result = RESULT_UNKNOWN;
+  d_stats->shard().reset_cur();
 
   /* If seeded, run in main process. */
   if (run_forked)
   {
+    if (d_smt2_pool) d_smt2_pool->checkout();
     pid_solver = fork();
 
     MURXLA_CHECK(pid_solver >= 0) << "forking solver process failed.";
@@ -700,8 +1580,13 @@ Murxla::run_aux(uint64_t seed,
       }
     }
 
-    /* Wait for the first process to finish (pid_solver or pid_timeout). */
-    pid_t exited_pid = wait(&status);
+    /* Wait for the first process to finish (pid_solver or pid_timeout).
+     * Pooled online solver processes are children of this process, too. */
+    pid_t exited_pid;
+    do
+    {
+      exited_pid = wait(&status);
+    } while (exited_pid > 0 && d_smt2_pool && d_smt2_pool->reaped(exited_pid));
 
     if (exited_pid == pid_solver)
     {
@@ -711,22 +1596,7 @@ Murxla::run_aux(uint64_t seed,
         kill(pid_timeout, SIGKILL);
         waitpid(pid_timeout, nullptr, 0);
       }
-      if (WIFEXITED(status))
-      {
-        switch (WEXITSTATUS(status))
-        {
-          case EXIT_OK: result = RESULT_OK; break;
-          case EXIT_ERROR_CONFIG: result = RESULT_ERROR_CONFIG; break;
-          case EXIT_ERROR_UNTRACE: result = RESULT_ERROR_UNTRACE; break;
-          default:
-            assert(WEXITSTATUS(status) == EXIT_ERROR);
-            result = RESULT_ERROR;
-        }
-      }
-      else if (WIFSIGNALED(status))
-      {
-        result = RESULT_ERROR;
-      }
+      result = status_to_result(status);
       if (result == RESULT_ERROR_CONFIG || result == RESULT_ERROR_UNTRACE)
       {
         std::ifstream ferr(file_err);
@@ -754,6 +1624,7 @@ Murxla::run_aux(uint64_t seed,
       waitpid(pid_solver, nullptr, 0);
       result = RESULT_TIMEOUT;
     }
+    if (d_smt2_pool) d_smt2_pool->checkin(result == RESULT_OK);
   }
   /* child */
   else
@@ -787,15 +1658,33 @@ Murxla::run_aux(uint64_t seed,
 
     try
     {
-      FSM fsm = create_fsm(
-          rng, sng, trace, smt2_out, record_stats, !untrace_file_name.empty());
+      FSM fsm = create_fsm(rng,
+                           sng,
+                           trace,
+                           smt2_out,
+                           record_stats,
+                           !untrace_file_name.empty() && !d_resume);
 
       fsm.configure();
 
+      /* Apply the learned coverage weights, not needed for untracing since
+       * the actions are determined by the trace. */
+      if (d_cov_feedback && (untrace_file_name.empty() || d_resume))
+      {
+        fsm.scale_action_weights(d_cov_feedback->get_action_weights());
+        fsm.get_smgr().set_op_weights(d_cov_feedback->get_op_weights());
+      }
+
       /* replay/untrace given API trace */
       if (!untrace_file_name.empty())
       {
         fsm.untrace(untrace_file_name);
+        /* resume from replayed corpus trace prefix */
+        if (d_resume)
+        {
+          rng.reseed(seed);
+          fsm.resume();
+        }
       }
       /* regular MBT run */
       else
@@ -831,6 +1720,329 @@ Murxla::run_aux(uint64_t seed,
   return result;
 }
 
+Result
+Murxla::run_lines(uint64_t seed,
+                  double time,
+                  const std::vector<std::vector<std::string>>& lines,
+                  const std::vector<size_t>& indices,
+                  std::string& out,
+                  std::string& err,
+                  const OutputCheck& check)
+{
+  int32_t fd_out[2], fd_err[2], status = 0;
+  Result result;
+
+  out.clear();
+  err.clear();
+  create_output_pipe(fd_out);
+  create_output_pipe(fd_err);
+
+  std::cout << std::flush;
+  std::cerr << std::flush;
+
+  if (d_smt2_pool) d_smt2_pool->checkout();
+  pid_t pid = fork();
+  MURXLA_CHECK(pid >= 0) << "forking solver process failed.";
+
+  /* child */
+  if (pid == 0)
+  {
+    signal(SIGINT, SIG_DFL);  // reset stats signal handler
+#ifdef MURXLA_COVERAGE
+    signal(SIGABRT, handle_abort);
+#endif
+    dup2(fd_out[1], STDOUT_FILENO);
+    dup2(fd_err[1], STDERR_FILENO);
+    close(fd_out[0]);
+    close(fd_out[1]);
+    close(fd_err[0]);
+    close(fd_err[1]);
+
+    std::ofstream file_trace = open_output_file(DEVNULL, false);
+    std::ostream trace(file_trace.rdbuf());
+    std::ostream smt2_out(std::cout.rdbuf());
+    if (d_options.solver == SOLVER_SMT2)
+    {
+      smt2_out.rdbuf(file_trace.rdbuf());
+    }
+    RNGenerator rng(seed);
+    SolverSeedGenerator sng(seed);
+
+    run_forked_and_exit([&]() {
+      FSM fsm = create_fsm(rng, sng, trace, smt2_out, false, true);
+      fsm.configure();
+      std::stringstream ss;
+      DD::write_lines(ss, lines, indices);
+      fsm.untrace(ss, "<dd>");
+    });
+  }
+
+  /* parent */
+  close(fd_out[1]);
+  close(fd_err[1]);
+
+  CollectResult res = collect_output(
+      pid, -1, fd_out[0], fd_err[0], out, err, time, check, status);
+  if (res == CollectResult::DONE)
+  {
+    result = status_to_result(status);
+    if (result == RESULT_ERROR_CONFIG || result == RESULT_ERROR_UNTRACE)
+    {
+      d_error_msg = err;
+    }
+  }
+  else if (res == CollectResult::ABORTED)
+  {
+    if (d_options.solver == SOLVER_SMT2 && !d_options.solver_binary.empty())
+    {
+      kill(pid, SIGINT);
+      usleep(100);
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+    result = RESULT_UNKNOWN;
+  }
+  else
+  {
+#ifdef MURXLA_COVERAGE
+    /* Try to trigger the abort handler to dump coverage information. */
+    kill(pid, SIGABRT);
+    usleep(100);
+#endif
+    /* Signal the SMT2 solver to kill the online solver process. */
+    if (d_options.solver == SOLVER_SMT2 && !d_options.solver_binary.empty())
+    {
+      kill(pid, SIGINT);
+      usleep(100);
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+    result = RESULT_TIMEOUT;
+  }
+  if (d_smt2_pool) d_smt2_pool->checkin(result == RESULT_OK);
+
+  close(fd_out[0]);
+  close(fd_err[0]);
+  return result;
+}
+
+bool
+Murxla::start_snapshot(uint64_t seed,
+                       double time,
+                       const std::vector<std::vector<std::string>>& lines,
+                       const std::vector<size_t>& indices)
+{
+  /* Forking the snapshot process would share the pipes to the online solver
+   * between all replayed suffixes. */
+  if (d_options.solver == SOLVER_SMT2 && !d_options.solver_binary.empty())
+  {
+    return false;
+  }
+
+  stop_snapshot();
+
+  int32_t fd_cmd[2], fd_res[2], fd_out[2], fd_err[2];
+  MURXLA_CHECK(pipe(fd_cmd) == 0 && pipe(fd_res) == 0)
+      << "creating snapshot pipes failed";
+  create_output_pipe(fd_out);
+  create_output_pipe(fd_err);
+
+  std::cout << std::flush;
+  std::cerr << std::flush;
+
+  d_snapshot_pid = fork();
+  MURXLA_CHECK(d_snapshot_pid >= 0) << "forking snapshot process failed.";
+
+  /* parent */
+  if (d_snapshot_pid)
+  {
+    close(fd_cmd[0]);
+    close(fd_res[1]);
+    close(fd_out[1]);
+    close(fd_err[1]);
+    d_snapshot_fd_cmd = fd_cmd[1];
+    d_snapshot_fd_res = fd_res[0];
+    d_snapshot_fd_out = fd_out[0];
+    d_snapshot_fd_err = fd_err[0];
+    d_snapshot_out.clear();
+    d_snapshot_err.clear();
+
+    /* Wait until the prefix is replayed. */
+    int32_t ready = 0, status;
+    if (collect_output(0,
+                       d_snapshot_fd_res,
+                       d_snapshot_fd_out,
+                       d_snapshot_fd_err,
+                       d_snapshot_out,
+                       d_snapshot_err,
+                       time,
+                       nullptr,
+                       status)
+            != CollectResult::DONE
+        || !read_fd(d_snapshot_fd_res, &ready, sizeof(ready)))
+    {
+      stop_snapshot();
+      return false;
+    }
+    return true;
+  }
+
+  /* snapshot process */
+  signal(SIGINT, SIG_DFL);  // reset stats signal handler
+  close(fd_cmd[1]);
+  close(fd_res[0]);
+  dup2(fd_out[1], STDOUT_FILENO);
+  dup2(fd_err[1], STDERR_FILENO);
+  close(fd_out[0]);
+  close(fd_out[1]);
+  close(fd_err[0]);
+  close(fd_err[1]);
+
+  std::ofstream file_trace = open_output_file(DEVNULL, false);
+  std::ostream trace(file_trace.rdbuf());
+  std::ostream smt2_out(std::cout.rdbuf());
+  if (d_options.solver == SOLVER_SMT2)
+  {
+    smt2_out.rdbuf(file_trace.rdbuf());
+  }
+
+  RNGenerator rng(seed);
+  SolverSeedGenerator sng(seed);
+
+  try
+  {
+    FSM fsm = create_fsm(rng, sng, trace, smt2_out, false, true);
+    fsm.configure();
+    {
+      std::stringstream ss;
+      DD::write_lines(ss, lines, indices);
+      fsm.untrace(ss, "<dd>");
+    }
+
+    std::cout << std::flush;
+    std::cerr << std::flush;
+    fflush(nullptr);
+
+    int32_t ready = 1;
+    if (!write_fd(fd_res[1], &ready, sizeof(ready))) _exit(EXIT_OK);
+
+    /* Serve suffix replay requests until the parent closes the pipe. */
+    std::string suffix;
+    while (read_fd_str(fd_cmd[0], suffix))
+    {
+      pid_t pid = fork();
+      if (pid < 0) break;
+
+      /* replay suffix */
+      if (pid == 0)
+      {
+        close(fd_cmd[0]);
+        close(fd_res[1]);
+        run_forked_and_exit([&]() {
+          std::stringstream ss(suffix);
+          fsm.untrace(ss, "<dd>");
+        });
+      }
+
+      int32_t status = 0;
+      if (!write_fd(fd_res[1], &pid, sizeof(pid))) break;
+      waitpid(pid, &status, 0);
+      if (!write_fd(fd_res[1], &status, sizeof(status))) break;
+    }
+  }
+  catch (MurxlaException& e)
+  {
+    /* Prefix replay failed, parent falls back to regular test runs. */
+  }
+  /* Do not run destructors of the replayed prefix, the solver state is shared
+   * with the forked suffix replays. */
+  _exit(EXIT_OK);
+}
+
+Result
+Murxla::run_snapshot(double time,
+                     const std::string& suffix,
+                     std::string& out,
+                     std::string& err,
+                     const OutputCheck& check)
+{
+  assert(has_snapshot());
+
+  pid_t pid;
+  int32_t status;
+  Result result;
+
+  out = d_snapshot_out;
+  err = d_snapshot_err;
+
+  if (!write_fd_str(d_snapshot_fd_cmd, suffix)
+      || !read_fd(d_snapshot_fd_res, &pid, sizeof(pid)))
+  {
+    stop_snapshot();
+    return RESULT_UNKNOWN;
+  }
+
+  CollectResult res = collect_output(0,
+                                     d_snapshot_fd_res,
+                                     d_snapshot_fd_out,
+                                     d_snapshot_fd_err,
+                                     out,
+                                     err,
+                                     time,
+                                     check,
+                                     status);
+  if (res != CollectResult::DONE)
+  {
+    /* Kill suffix replay and wait until the snapshot process reaped it. */
+    kill(pid, SIGKILL);
+    result = res == CollectResult::TIMEOUT ? RESULT_TIMEOUT : RESULT_UNKNOWN;
+    collect_output(0,
+                   d_snapshot_fd_res,
+                   d_snapshot_fd_out,
+                   d_snapshot_fd_err,
+                   out,
+                   err,
+                   0,
+                   nullptr,
+                   status);
+    if (!read_fd(d_snapshot_fd_res, &status, sizeof(status)))
+    {
+      stop_snapshot();
+    }
+  }
+  else if (!read_fd(d_snapshot_fd_res, &status, sizeof(status)))
+  {
+    stop_snapshot();
+    return RESULT_UNKNOWN;
+  }
+  else
+  {
+    result = status_to_result(status);
+    if (result == RESULT_ERROR_CONFIG || result == RESULT_ERROR_UNTRACE)
+    {
+      d_error_msg = err;
+    }
+  }
+  return result;
+}
+
+void
+Murxla::stop_snapshot()
+{
+  if (!has_snapshot()) return;
+  close(d_snapshot_fd_cmd);
+  close(d_snapshot_fd_res);
+  close(d_snapshot_fd_out);
+  close(d_snapshot_fd_err);
+  kill(d_snapshot_pid, SIGKILL);
+  waitpid(d_snapshot_pid, nullptr, 0);
+  d_snapshot_pid    = 0;
+  d_snapshot_fd_cmd = -1;
+  d_snapshot_fd_res = -1;
+  d_snapshot_fd_out = -1;
+  d_snapshot_fd_err = -1;
+}
+
 std::string
 Murxla::filter_error(const std::string& err)
 {
@@ -903,6 +2115,44 @@ Murxla::add_error(const std::string& err, uint64_t seed)
   return std::make_tuple(ErrorKind::ERROR, filtered_err, d_errors->size(), 1);
 }
 
+std::tuple<Murxla::ErrorKind, const std::string, uint64_t, uint64_t>
+Murxla::add_timeout(uint64_t seed)
+{
+  const statistics::StatisticsShard& shard = d_stats->shard();
+  std::stringstream ss;
+  ss << "timeout in ";
+  if (shard.d_cur_action < 0)
+  {
+    ss << "solver setup";
+  }
+  else
+  {
+    const char* action = d_stats->d_action_kinds[shard.d_cur_action];
+    ss << "'" << std::string(action, strnlen(action, MURXLA_MAX_KIND_LEN))
+       << "'";
+    if (shard.d_cur_op >= 0)
+    {
+      const char* op = d_stats->d_op_kinds[shard.d_cur_op];
+      ss << " (op '" << std::string(op, strnlen(op, MURXLA_MAX_KIND_LEN))
+         << "')";
+    }
+  }
+  std::string key = ss.str();
+  ss << " at action " << shard.d_cur_action_idx;
+
+  auto it = d_timeouts->find(key);
+  if (it != d_timeouts->end())
+  {
+    it->second.seeds.push_back(seed);
+    return std::make_tuple(ErrorKind::DUPLICATE,
+                           ss.str(),
+                           it->second.id,
+                           it->second.seeds.size());
+  }
+  d_timeouts->emplace(key, ErrorInfo(d_timeouts->size() + 1, key, {seed}));
+  return std::make_tuple(ErrorKind::ERROR, ss.str(), d_timeouts->size(), 1);
+}
+
 void
 Murxla::load_solver_profile()
 {
@@ -956,7 +2206,9 @@ Murxla::get_smt2_file_name(uint64_t seed,
 }
 
 std::string
-Murxla::get_api_trace_file_name(uint64_t seed, uint64_t error_id) const
+Murxla::get_api_trace_file_name(uint64_t seed,
+                                uint64_t error_id,
+                                bool timeout) const
 {
   std::string api_trace_file_name = d_options.api_trace_file_name;
   if (api_trace_file_name.empty())
@@ -980,7 +2232,7 @@ Murxla::get_api_trace_file_name(uint64_t seed, uint64_t error_id) const
     if (error_id > 0)
     {
       std::stringstream ss;
-      ss << error_id;
+      ss << (timeout ? "timeout-" : "") << error_id;
       api_trace_file_name = prepend_path(ss.str(), api_trace_file_name);
     }
     if (!d_options.out_dir.empty())
@@ -10,7 +10,12 @@
 #ifndef __MURXLA__MURXLA_H
 #define __MURXLA__MURXLA_H
 
+#include <sys/types.h>
+
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 
 #include "action.hpp"
@@ -27,6 +32,14 @@ namespace murxla {
 namespace statistics {
 struct Statistics;
 };
+namespace smt2 {
+class Smt2OnlineSolverPool;
+};
+namespace coverage {
+class Feedback;
+};
+class Corpus;
+class Smt2Store;
 class Solver;
 
 /* -------------------------------------------------------------------------- */
@@ -48,6 +61,13 @@ class Murxla
  public:
   using ErrorMap = std::unordered_map<std::string, ErrorInfo>;
 
+  enum class ErrorKind
+  {
+    DUPLICATE, /* Error message is a duplicate since it was already reported. */
+    ERROR,     /* Error message is new. */
+    FILTER,    /* Error message filtered out. */
+  };
+
   enum TraceMode
   {
     NONE,
@@ -55,7 +75,16 @@ class Murxla
     TO_FILE,
   };
 
+  /**
+   * Check on the (partial) stdout and stderr output of a test run, returns
+   * false if the test run should be aborted early.
+   */
+  using OutputCheck =
+      std::function<bool(const std::string& out, const std::string& err)>;
+
   inline static const std::string API_TRACE = "tmp-api.trace";
+  /** The trace prefix file of the current mutated test run. */
+  inline static const std::string CORPUS_PREFIX = "tmp-corpus-prefix.trace";
   inline static const std::string SMT2_FILE = "tmp-smt2.smt2";
 
   /** Constructor. */
@@ -63,7 +92,10 @@ class Murxla
          const Options& options,
          SolverOptions* solver_options,
          ErrorMap* error_map,
+         ErrorMap* timeout_map,
          const std::string& tmp_dir);
+  /** Destructor. */
+  ~Murxla();
 
   /**
    * A single test run.
@@ -99,9 +131,158 @@ class Murxla
   /** Continuous test run. */
   void test();
 
+  /**
+   * Replay all trace files ('*.trace') in given directory and its
+   * subdirectories with 'num_jobs' parallel worker processes, and print a
+   * summary report.
+   *
+   * Each trace is classified as fixed, still failing with the same error,
+   * failing with a different error, or timing out.  The error of a trace is
+   * compared against the error recorded in file 'error.txt' in the same
+   * directory, as written in continuous mode.  Traces are replayed with the
+   * options given on the command line, traces recorded with different
+   * options are classified as invalid.  Each worker records the statistics
+   * of its replays into its own statistics shard.
+   *
+   * dir     : The directory of the trace files.
+   * num_jobs: The number of worker processes, 0 for one per hardware thread.
+   */
+  void replay_dir(const std::string& dir, uint32_t num_jobs);
+
+  /**
+   * A single test run that replays the given trace lines in a forked process.
+   *
+   * This is used for delta debugging.  The trace is given as a subset of
+   * already parsed trace lines, which is inherited by the forked process.
+   * Nothing is written to or read from disk: the stdout and stderr output of
+   * the test run is captured in memory.
+   *
+   * seed   : The current seed for the RNG.
+   * time   : The time limit for one test run.
+   * lines  : The parsed trace lines (see DD::write_lines()).
+   * indices: The indices of the lines in 'lines' to replay.
+   * out    : The resulting stdout output of the test run.
+   * err    : The resulting stderr output of the test run.
+   * check  : If given, checked whenever new output is available, the test
+   *          run is killed as soon as it returns false.
+   *
+   * Returns a result that indicates the status of the test run, or
+   * RESULT_UNKNOWN if the test run was aborted by 'check'.
+   */
+  Result run_lines(uint64_t seed,
+                   double time,
+                   const std::vector<std::vector<std::string>>& lines,
+                   const std::vector<size_t>& indices,
+                   std::string& out,
+                   std::string& err,
+                   const OutputCheck& check = nullptr);
+
+  /**
+   * Start a snapshot process that replays the given trace prefix once and
+   * then parks, waiting for trace suffixes to replay (see run_snapshot()).
+   *
+   * This is used for delta debugging, where many candidate traces share a
+   * common prefix.  Sorts and terms created while replaying the prefix
+   * remain registered with the solver manager of the parked process and are
+   * inherited by every forked suffix replay.
+   *
+   * seed   : The seed for the RNG.
+   * time   : The time limit for replaying the prefix.
+   * lines  : The parsed trace lines (see DD::write_lines()).
+   * indices: The indices of the lines in 'lines' that form the prefix.
+   *
+   * Returns true if the prefix was replayed successfully.
+   */
+  bool start_snapshot(uint64_t seed,
+                      double time,
+                      const std::vector<std::vector<std::string>>& lines,
+                      const std::vector<size_t>& indices);
+
+  /**
+   * Replay a trace suffix in a process forked off the snapshot process.
+   *
+   * The stdout and stderr output of the suffix replay is appended to the
+   * output of the prefix replay, so that it matches the output of a regular
+   * run of the full trace.
+   *
+   * time  : The time limit for replaying the suffix.
+   * suffix: The trace suffix to replay.
+   * out   : The resulting stdout output of the test run.
+   * err   : The resulting stderr output of the test run.
+   * check : If given, checked whenever new output is available, the test run
+   *         is killed as soon as it returns false.
+   *
+   * Returns a result that indicates the status of the test run, or
+   * RESULT_UNKNOWN if the test run was aborted by 'check' or if the snapshot
+   * process died (it is stopped in that case, see has_snapshot()).
+   */
+  Result run_snapshot(double time,
+                      const std::string& suffix,
+                      std::string& out,
+                      std::string& err,
+                      const OutputCheck& check = nullptr);
+
+  /** Terminate the snapshot process, if any. */
+  void stop_snapshot();
+
+  /** Return true if a snapshot process is running. */
+  bool has_snapshot() const { return d_snapshot_pid > 0; }
+
   /** Print the current configuration of the FSM to stdout. */
   void print_fsm() const;
 
+  /**
+   * Register error to d_errors.
+   *
+   * Returns a tuple of the error kind, the filtered error message, the id of
+   * the error and the number of seeds that triggered it.
+   */
+  std::tuple<Murxla::ErrorKind, const std::string, uint64_t, uint64_t>
+  add_error(const std::string& err, uint64_t seed);
+
+  /** The classification of a trace replayed via replay_dir(). */
+  enum class ReplayKind
+  {
+    FIXED,           /* No error. */
+    SAME_ERROR,      /* Same error as recorded for the trace. */
+    DIFFERENT_ERROR, /* Different error than recorded for the trace. */
+    ERROR,           /* Error, no error recorded for the trace. */
+    TIMEOUT,         /* Time limit exceeded. */
+    INVALID,         /* Trace can not be replayed. */
+  };
+
+  /**
+   * Worker process of replay_dir().  Replays the traces with the next index
+   * not yet claimed by another worker, and writes the classification of each
+   * trace to the results file of this worker.
+   *
+   * worker: The index of the worker.
+   * traces: The trace files to replay.
+   * next  : The index of the next trace to replay, shared by all workers.
+   */
+  void replay_dir_worker(uint32_t worker,
+                         const std::vector<std::string>& traces,
+                         std::atomic<uint64_t>& next);
+
+  /**
+   * Classify the result of a trace replayed via replay_dir().
+   *
+   * trace_file_name: The replayed trace.
+   * res            : The result of the replay.
+   * err            : The stderr output of the replay.
+   */
+  ReplayKind classify_replay(const std::string& trace_file_name,
+                             Result res,
+                             const std::string& err);
+
+  /**
+   * Determine if the solvers of a cross-check or vote setup may run
+   * concurrently.
+   *
+   * solver_kinds: The kinds of all solver instances of the setup.
+   */
+  bool is_concurrent(const std::vector<SolverKind>& solver_kinds) const;
+
   /**
    * Create solver.
    *
@@ -127,13 +308,6 @@ class Murxla
   std::string d_error_msg;
 
  private:
-  enum class ErrorKind
-  {
-    DUPLICATE, /* Error message is a duplicate since it was already reported. */
-    ERROR,     /* Error message is new. */
-    FILTER,    /* Error message filtered out. */
-  };
-
   /**
    * Create solver.
    *
@@ -205,6 +379,10 @@ class Murxla
    * err_file_name      : The name of the file to write stderr output to.
    * api_trace_file_name: The name of the file to write the API trace to.
    * untrace_file_name  : The name of the trace file to replay.
+   * held_trace_name    : Set to the name of the trace we already hold if the
+   *                      replayed trace is a duplicate (see
+   *                      find_duplicate_trace()), in which case the replayed
+   *                      trace is removed and not minimized.
    *
    * Returns a result that indicates the status of the test run.
    */
@@ -212,14 +390,43 @@ class Murxla
                 const std::string& out_file_name,
                 const std::string& err_file_name,
                 const std::string& api_trace_file_name,
-                const std::string& untrace_file_name);
+                const std::string& untrace_file_name,
+                std::string& held_trace_name);
+
+  /**
+   * Check if we already hold a trace with the same canonical form as the
+   * given trace (see canonicalize_trace()).
+   *
+   * trace_file_name: The trace to check.
+   *
+   * Returns the name of the held trace if the given trace is a duplicate, and
+   * else records the given trace as held and returns an empty string.
+   */
+  std::string find_duplicate_trace(const std::string& trace_file_name);
 
   /** Filter error messages based on filter regex provided in solver profile. */
   std::string filter_error(const std::string& err);
 
-  /** Register error to d_errors. */
+  /**
+   * Register timeout of the last test run to d_timeouts.
+   *
+   * Timeouts are grouped by the action (and operator) that was executed when
+   * the test run was killed, as published by the test run in d_stats.
+   */
   std::tuple<Murxla::ErrorKind, const std::string, uint64_t, uint64_t>
-  add_error(const std::string& err, uint64_t seed);
+  add_timeout(uint64_t seed);
+
+  /**
+   * Write a status snapshot of the continuous test run to the file given via
+   * --stats-file.  The snapshot is replaced atomically.
+   *
+   * num_runs    : The number of test runs so far.
+   * num_timeouts: The number of test runs that timed out so far.
+   * elapsed     : The wall clock time in seconds since the start.
+   */
+  void write_stats_file(uint32_t num_runs,
+                        uint64_t num_timeouts,
+                        double elapsed) const;
 
   /** Load solver profile of currently configured solver. */
   void load_solver_profile();
@@ -228,12 +435,20 @@ class Murxla
                                  const std::string& untrace_file_name) const;
 
   std::string get_api_trace_file_name(uint64_t seed,
-                                      uint64_t error_id = 0) const;
+                                      uint64_t error_id = 0,
+                                      bool timeout      = false) const;
 
   /** Statistics of current test run(s). */
   statistics::Statistics* d_stats;
+  /**
+   * Dummy statistics object for the cases were we don't want to record
+   * statistics (replay, dd).
+   */
+  statistics::Statistics* d_dummy_stats = nullptr;
   /** Map normalized error message to pair (original error message, seeds). */
   ErrorMap* d_errors;
+  /** Map timeout group (the hanging action) to pair (message, seeds). */
+  ErrorMap* d_timeouts;
 
   std::unordered_set<std::string> d_exclude_errors;
   std::vector<std::string> d_error_filters;
@@ -242,6 +457,55 @@ class Murxla
 
   /** Stores error messages to be exported when --export-errors is enabled. */
   std::vector<std::string> d_export_errors;
+
+  /** The pid of the snapshot process, 0 if not running. */
+  pid_t d_snapshot_pid = 0;
+  /** The write end of the pipe for sending commands to the snapshot process. */
+  int32_t d_snapshot_fd_cmd = -1;
+  /** The read end of the pipe for reading results of the snapshot process. */
+  int32_t d_snapshot_fd_res = -1;
+  /** The read end of the pipe capturing stdout of the snapshot process. */
+  int32_t d_snapshot_fd_out = -1;
+  /** The read end of the pipe capturing stderr of the snapshot process. */
+  int32_t d_snapshot_fd_err = -1;
+  /** The stdout output of the prefix replayed by the snapshot process. */
+  std::string d_snapshot_out;
+  /** The stderr output of the prefix replayed by the snapshot process. */
+  std::string d_snapshot_err;
+
+  /**
+   * The pool of online SMT2 solver processes reused across test runs, nullptr
+   * if not in online SMT2 mode.
+   */
+  std::unique_ptr<smt2::Smt2OnlineSolverPool> d_smt2_pool;
+  /**
+   * The content-addressed store for offline SMT2 files, nullptr if SMT2 files
+   * are written separately.
+   */
+  std::unique_ptr<Smt2Store> d_smt2_store;
+  /**
+   * The coverage feedback used to weight actions and operators, nullptr if
+   * coverage-guided weighting is disabled.
+   */
+  std::unique_ptr<coverage::Feedback> d_cov_feedback;
+  /**
+   * The corpus of traces of interesting test runs, nullptr if not enabled
+   * via --corpus.
+   */
+  std::unique_ptr<Corpus> d_corpus;
+  /**
+   * True if the current test run replays a corpus trace prefix (given as
+   * untrace file) and then resumes random generation (see FSM::resume()).
+   */
+  bool d_resume = false;
+  /**
+   * The seed of the corpus trace the current test run resumes from.  The FSM
+   * is configured with this seed, random generation after the prefix uses
+   * the seed of the test run.
+   */
+  uint64_t d_resume_seed = 0;
+  /** Map canonical trace hash to the file name of the trace we hold. */
+  std::unordered_map<uint64_t, std::string> d_trace_hashes;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -22,6 +22,7 @@ using SolverKind              = std::string;
 const SolverKind SOLVER_BTOR  = "btor";
 const SolverKind SOLVER_BZLA  = "bzla";
 const SolverKind SOLVER_CVC5  = "cvc5";
+const SolverKind SOLVER_MOCK  = "mock";
 const SolverKind SOLVER_SMT2  = "smt2";
 const SolverKind SOLVER_YICES = "yices";
 
@@ -44,6 +45,27 @@ struct Options
   bool smtlib_compliant = false;
   /** True to print statistics. */
   bool print_stats = false;
+  /** The file to export statistics to in JSON format, empty if disabled. */
+  std::string stats_json_file_name;
+  /**
+   * The file to periodically write a JSON status snapshot to in continuous
+   * mode, empty if disabled.
+   */
+  std::string stats_file_name;
+  /** True to weight actions and operators based on solver code coverage. */
+  bool cov_feedback = false;
+  /**
+   * The file to load learned coverage weights from and persist them to, empty
+   * if disabled.
+   */
+  std::string cov_weights_file_name;
+  /**
+   * The directory to keep the traces of test runs with new coverage or new
+   * result/option combinations in, empty if disabled.
+   */
+  std::string corpus_dir;
+  /** True to resume test runs from random prefixes of corpus traces. */
+  bool mutate = false;
   /** True to print FSM configuration. */
   bool print_fsm = false;
   /** Restrict arithmetic operators to linear fragment. */
@@ -61,12 +83,31 @@ struct Options
   SolverKind solver;
   /** The path to the solver binary to test when --smt2 is enabled. */
   std::string solver_binary;
+  /**
+   * True to stream commands to the online solver without waiting for a
+   * 'success' response (--smt2 <binary> only).
+   */
+  bool smt2_pipeline = false;
   /** The file to trace the API call sequence to. */
   std::string api_trace_file_name;
   /** The API trace file to replay. */
   std::string untrace_file_name;
+  /** The directory of API trace files to replay in batch, empty if none. */
+  std::string replay_dir;
+  /**
+   * The number of parallel worker processes for replaying a directory of
+   * traces, 0 for one per hardware thread.
+   */
+  uint32_t jobs = 0;
   /** The file to dump the SMT-LIB2 representation of the current trace to. */
   std::string smt2_file_name;
+  /**
+   * The directory of the content-addressed store to write --smt2 output
+   * files to (see Smt2Store), empty to write separate files.
+   */
+  std::string smt2_store_dir;
+  /** The directory of the SMT2 store to extract. */
+  std::string smt2_extract_dir;
 
   /**
    * True if the API trace of the current run should be reduced by means of
@@ -92,9 +133,44 @@ struct Options
   std::string dd_match_err;
   /** The file to write the reduced API trace to. */
   std::string dd_trace_file_name;
+  /**
+   * Resume delta debugging from the checkpoint written next to the reduced
+   * API trace by a previous (interrupted) run.
+   */
+  bool dd_resume = false;
+  /**
+   * Minimize for a slowdown rather than for an error: keep candidates whose
+   * runtime stays above this time limit in seconds (in all of
+   * MURXLA_DD_SLOW_RUNS repeated runs), ignoring exit code and output.
+   * 0 if disabled.
+   */
+  double dd_slow = 0;
 
   /** The name of the solver to cross-check given solver with. */
   std::string cross_check;
+  /**
+   * True to execute expensive calls on the solver under test and the
+   * cross-check solver concurrently.
+   */
+  bool cross_check_concurrent = false;
+  /**
+   * The solvers to test the selected solver against via majority vote
+   * (see shadow::ShadowSolver).
+   */
+  std::vector<SolverKind> vote_solvers;
+
+  /**
+   * The time limit in seconds for a single satisfiability check, checks
+   * that exceed this limit are reported as performance anomaly.
+   * 0 if disabled.
+   */
+  double perf_time = 0;
+  /**
+   * The maximum ratio of the time of a satisfiability check of the solver
+   * under test to the time of the cross-check (or vote) solvers, checks that
+   * exceed this ratio are reported as performance anomaly.  0 if disabled.
+   */
+  double perf_ratio = 0;
 
   /** The name of the solver to use for checking. */
   std::string check_solver_name;
@@ -0,0 +1,203 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "smt2_store.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#include "config.hpp"
+#include "except.hpp"
+#include "util.hpp"
+
+namespace murxla {
+
+namespace {
+
+/** An entry of the index file. */
+struct IndexEntry
+{
+  std::string d_key;
+  uint64_t d_segment_id = 0;
+  uint64_t d_offset     = 0;
+  uint64_t d_compr_size = 0;
+  std::string d_name;
+};
+
+/** Parse a line of the index file, returns false if it is malformed. */
+bool
+parse_index_line(const std::string& line, IndexEntry& entry)
+{
+  std::stringstream ss(line);
+  ss >> entry.d_key >> entry.d_segment_id >> entry.d_offset
+      >> entry.d_compr_size;
+  if (ss.fail()) return false;
+  std::getline(ss >> std::ws, entry.d_name);
+  return !entry.d_name.empty();
+}
+
+/** Get the key of a benchmark, its content hash and size. */
+std::string
+get_key(const std::string& content)
+{
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << fnv1a_hash(content)
+     << "-" << std::dec << content.size();
+  return ss.str();
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+Smt2Store::Smt2Store(const std::string& dir) : d_dir(dir)
+{
+  std::filesystem::create_directories(d_dir);
+
+  std::string index_file_name = prepend_path(d_dir, INDEX_FILE);
+  std::stringstream index;
+  {
+    std::ifstream in(index_file_name, std::ios::binary);
+    index << in.rdbuf();
+  }
+
+  /* A trailing line without newline was torn by an interrupted write.  Its
+   * data is not referenced by the index, drop it such that the next entry
+   * starts on a new line. */
+  std::string content = index.str();
+  size_t pos          = content.rfind('\n');
+  size_t size         = pos == std::string::npos ? 0 : pos + 1;
+  if (size < content.size())
+  {
+    std::filesystem::resize_file(index_file_name, size);
+    index.str(content.substr(0, size));
+  }
+
+  std::string line;
+  IndexEntry entry;
+  while (std::getline(index, line))
+  {
+    if (!parse_index_line(line, entry)) continue;
+    d_keys.insert(entry.d_key);
+    d_segment_id = std::max(d_segment_id, entry.d_segment_id);
+  }
+
+  d_index.open(index_file_name, std::ios::app);
+  MURXLA_CHECK(d_index.is_open())
+      << "unable to open SMT2 store index '" << index_file_name << "'";
+  open_segment();
+}
+
+bool
+Smt2Store::add(const std::string& name, const std::string& content)
+{
+  std::string key = get_key(content);
+  if (!d_keys.insert(key).second)
+  {
+    d_num_duplicates += 1;
+    return false;
+  }
+
+  if (d_segment_size >= MURXLA_SMT2_STORE_SEGMENT_SIZE)
+  {
+    d_segment_id += 1;
+    open_segment();
+  }
+
+  std::string compressed = lz_compress(content);
+  d_segment.write(compressed.data(), compressed.size());
+  d_segment.flush();
+  MURXLA_CHECK(d_segment.good()) << "writing to SMT2 store failed";
+
+  /* Only add to the index after the data has been written. */
+  d_index << key << " " << d_segment_id << " " << d_segment_size << " "
+          << compressed.size() << " " << name << std::endl;
+  MURXLA_CHECK(d_index.good()) << "writing to SMT2 store index failed";
+
+  d_segment_size += compressed.size();
+  d_num_added += 1;
+  return true;
+}
+
+std::string
+Smt2Store::get_segment_file_name(uint64_t id) const
+{
+  return prepend_path(d_dir, "segment-" + std::to_string(id) + ".lz");
+}
+
+void
+Smt2Store::open_segment()
+{
+  std::string file_name = get_segment_file_name(d_segment_id);
+  d_segment.close();
+  d_segment.open(file_name, std::ios::binary | std::ios::app);
+  MURXLA_CHECK(d_segment.is_open())
+      << "unable to open SMT2 store segment '" << file_name << "'";
+  /* Data of interrupted writes is not referenced by the index, we always
+   * append after it. */
+  d_segment_size = std::filesystem::file_size(file_name);
+}
+
+uint64_t
+Smt2Store::extract(const std::string& dir, const std::string& out_dir)
+{
+  std::string index_file_name = prepend_path(dir, INDEX_FILE);
+  std::ifstream index(index_file_name);
+  MURXLA_EXIT_ERROR(!index.is_open())
+      << "unable to open SMT2 store index '" << index_file_name << "'";
+
+  if (!out_dir.empty()) std::filesystem::create_directories(out_dir);
+
+  std::unordered_map<uint64_t, std::ifstream> segments;
+  std::string line, compressed, content;
+  IndexEntry entry;
+  uint64_t res = 0;
+  while (std::getline(index, line))
+  {
+    /* Skip a trailing line torn by an interrupted write, see Smt2Store(). */
+    if (index.eof()) break;
+    MURXLA_EXIT_ERROR(!parse_index_line(line, entry))
+        << "malformed SMT2 store index entry '" << line << "'";
+
+    auto it = segments.find(entry.d_segment_id);
+    if (it == segments.end())
+    {
+      std::string file_name = prepend_path(
+          dir, "segment-" + std::to_string(entry.d_segment_id) + ".lz");
+      it = segments.emplace(entry.d_segment_id, std::ifstream(file_name))
+               .first;
+      MURXLA_EXIT_ERROR(!it->second.is_open())
+          << "unable to open SMT2 store segment '" << file_name << "'";
+    }
+
+    compressed.resize(entry.d_compr_size);
+    it->second.seekg(entry.d_offset);
+    it->second.read(compressed.data(), compressed.size());
+    MURXLA_EXIT_ERROR(!it->second.good() || !lz_decompress(compressed, content)
+                      || get_key(content) != entry.d_key)
+        << "corrupted SMT2 store entry '" << line << "'";
+
+    std::string file_name = out_dir.empty()
+                                ? entry.d_name
+                                : prepend_path(out_dir, entry.d_name);
+    std::ofstream out(file_name, std::ios::binary);
+    out << content;
+    MURXLA_EXIT_ERROR(!out.good())
+        << "unable to write extracted file '" << file_name << "'";
+    res += 1;
+  }
+  return res;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
@@ -0,0 +1,97 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__SMT2_STORE_H
+#define __MURXLA__SMT2_STORE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+
+namespace murxla {
+
+/**
+ * A content-addressed store for SMT2 files.
+ *
+ * Instead of writing one file per generated SMT2 benchmark, benchmarks are
+ * compressed (see lz_compress()) and appended to segment files of at most
+ * MURXLA_SMT2_STORE_SEGMENT_SIZE bytes.  Benchmarks are identified by the
+ * hash and size of their content, exact duplicates are dropped.
+ *
+ * The store directory contains the segment files 'segment-<id>.lz' and a
+ * text index file 'index' with one line per stored benchmark:
+ *
+ *   <hash>-<size> <segment id> <offset> <compressed size> <file name>
+ *
+ * A store may be reused over multiple runs, but not concurrently.
+ */
+class Smt2Store
+{
+ public:
+  /** The name of the index file. */
+  inline static const std::string INDEX_FILE = "index";
+
+  /**
+   * Extract all benchmarks of a store.
+   * dir    : The directory of the store.
+   * out_dir: The directory to write the extracted files to.
+   * Returns the number of extracted files.
+   */
+  static uint64_t extract(const std::string& dir, const std::string& out_dir);
+
+  /**
+   * Constructor.
+   * Creates the store directory if it does not exist yet, else loads the
+   * index of the existing store and drops a trailing index line that was
+   * torn by an interrupted run.
+   * dir: The directory of the store.
+   */
+  Smt2Store(const std::string& dir);
+
+  /**
+   * Add benchmark to the store.
+   * name   : The file name of the benchmark.
+   * content: The content of the benchmark.
+   * Returns false if the benchmark is a duplicate of a stored benchmark.
+   */
+  bool add(const std::string& name, const std::string& content);
+
+  /** Get the number of benchmarks added to the store by this instance. */
+  uint64_t get_num_added() const { return d_num_added; }
+  /** Get the number of duplicates dropped by this instance. */
+  uint64_t get_num_duplicates() const { return d_num_duplicates; }
+
+ private:
+  /** Get the path of the segment file with given id. */
+  std::string get_segment_file_name(uint64_t id) const;
+  /** Open the current segment file for appending. */
+  void open_segment();
+
+  /** The directory of the store. */
+  std::string d_dir;
+  /** The keys (content hash and size) of the stored benchmarks. */
+  std::unordered_set<std::string> d_keys;
+  /** The index file. */
+  std::ofstream d_index;
+  /** The current segment file. */
+  std::ofstream d_segment;
+  /** The id of the current segment file. */
+  uint64_t d_segment_id = 0;
+  /** The size of the current segment file. */
+  uint64_t d_segment_size = 0;
+  /** The number of benchmarks added by this instance. */
+  uint64_t d_num_added = 0;
+  /** The number of duplicates dropped by this instance. */
+  uint64_t d_num_duplicates = 0;
+};
+
+}  // namespace murxla
+
+#endif
@@ -9,14 +9,19 @@
  */
 #include "solver/meta/shadow_solver.hpp"
 
+#include <sstream>
+
+#include "config.hpp"
 #include "solver/solver_profile.hpp"
 
 namespace murxla {
 namespace shadow {
 
-ShadowSort::ShadowSort(Sort sort, Sort sort_shadow)
-    : d_sort(sort), d_sort_shadow(sort_shadow)
+ShadowSort::ShadowSort(const std::vector<Sort>& sorts)
+    : d_backend_sorts(sorts)
 {
+  assert(!d_backend_sorts.empty());
+  assert(d_backend_sorts[0]);
 }
 
 ShadowSort::~ShadowSort() {}
@@ -24,235 +29,236 @@ ShadowSort::~ShadowSort() {}
 size_t
 ShadowSort::hash() const
 {
-  return d_sort->hash();
+  return d_backend_sorts[0]->hash();
 }
 
 bool
 ShadowSort::equals(const Sort& other) const
 {
   ShadowSort* s_sort = checked_cast<ShadowSort*>(other.get());
-  return d_sort->equals(s_sort->d_sort)
-         && d_sort_shadow->equals(s_sort->d_sort_shadow);
+  assert(s_sort->d_backend_sorts.size() == d_backend_sorts.size());
+  for (size_t i = 0, n = d_backend_sorts.size(); i < n; ++i)
+  {
+    if (d_backend_sorts[i] && s_sort->d_backend_sorts[i]
+        && !d_backend_sorts[i]->equals(s_sort->d_backend_sorts[i]))
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
 std::string
 ShadowSort::to_string() const
 {
-  return d_sort->to_string();
+  return d_backend_sorts[0]->to_string();
 }
 
 bool
 ShadowSort::is_array() const
 {
-  return d_sort->is_array();
+  return d_backend_sorts[0]->is_array();
 }
 
 bool
 ShadowSort::is_bag() const
 {
-  return d_sort->is_bag();
+  return d_backend_sorts[0]->is_bag();
 }
 
 bool
 ShadowSort::is_bool() const
 {
-  return d_sort->is_bool();
+  return d_backend_sorts[0]->is_bool();
 }
 
 bool
 ShadowSort::is_bv() const
 {
-  return d_sort->is_bv();
+  return d_backend_sorts[0]->is_bv();
 }
 
 bool
 ShadowSort::is_dt() const
 {
-  return d_sort->is_dt();
+  return d_backend_sorts[0]->is_dt();
 }
 
 bool
 ShadowSort::is_dt_parametric() const
 {
-  return d_sort->is_dt_parametric();
+  return d_backend_sorts[0]->is_dt_parametric();
 }
 
 bool
 ShadowSort::is_fp() const
 {
-  return d_sort->is_fp();
+  return d_backend_sorts[0]->is_fp();
 }
 
 bool
 ShadowSort::is_fun() const
 {
-  return d_sort->is_fun();
+  return d_backend_sorts[0]->is_fun();
 }
 
 bool
 ShadowSort::is_int() const
 {
-  return d_sort->is_int();
+  return d_backend_sorts[0]->is_int();
 }
 
 bool
 ShadowSort::is_real() const
 {
-  return d_sort->is_real();
+  return d_backend_sorts[0]->is_real();
 }
 
 bool
 ShadowSort::is_rm() const
 {
-  return d_sort->is_rm();
+  return d_backend_sorts[0]->is_rm();
 }
 
 bool
 ShadowSort::is_seq() const
 {
-  return d_sort->is_seq();
+  return d_backend_sorts[0]->is_seq();
 }
 
 bool
 ShadowSort::is_set() const
 {
-  return d_sort->is_set();
+  return d_backend_sorts[0]->is_set();
 }
 
 bool
 ShadowSort::is_string() const
 {
-  return d_sort->is_string();
+  return d_backend_sorts[0]->is_string();
 }
 
 bool
 ShadowSort::is_uninterpreted() const
 {
-  return d_sort->is_uninterpreted();
+  return d_backend_sorts[0]->is_uninterpreted();
 }
 
 bool
 ShadowSort::is_reglan() const
 {
-  return d_sort->is_reglan();
+  return d_backend_sorts[0]->is_reglan();
 }
 
 uint32_t
 ShadowSort::get_bv_size() const
 {
-  uint32_t res = d_sort->get_bv_size();
-  MURXLA_TEST(res == d_sort_shadow->get_bv_size());
-  return res;
+  return get_checked<uint32_t>(
+      [](const Sort& s) { return s->get_bv_size(); });
 }
 
 uint32_t
 ShadowSort::get_fp_exp_size() const
 {
-  uint32_t res = d_sort->get_fp_exp_size();
-  MURXLA_TEST(res == d_sort_shadow->get_fp_exp_size());
-  return res;
+  return get_checked<uint32_t>(
+      [](const Sort& s) { return s->get_fp_exp_size(); });
 }
 
 uint32_t
 ShadowSort::get_fp_sig_size() const
 {
-  uint32_t res = d_sort->get_fp_sig_size();
-  MURXLA_TEST(res == d_sort_shadow->get_fp_sig_size());
-  return res;
+  return get_checked<uint32_t>(
+      [](const Sort& s) { return s->get_fp_sig_size(); });
 }
 
 std::string
 ShadowSort::get_dt_name() const
 {
-  std::string res = d_sort->get_dt_name();
-  MURXLA_TEST(res == d_sort_shadow->get_dt_name());
-  return res;
+  return get_checked<std::string>(
+      [](const Sort& s) { return s->get_dt_name(); });
 }
 
 uint32_t
 ShadowSort::get_dt_num_cons() const
 {
-  uint32_t res = d_sort->get_dt_num_cons();
-  MURXLA_TEST(res == d_sort_shadow->get_dt_num_cons());
-  return res;
+  return get_checked<uint32_t>(
+      [](const Sort& s) { return s->get_dt_num_cons(); });
 }
 
 std::vector<std::string>
 ShadowSort::get_dt_cons_names() const
 {
-  std::vector<std::string> res = d_sort->get_dt_cons_names();
-  MURXLA_TEST(res == d_sort_shadow->get_dt_cons_names());
-  return res;
+  return get_checked<std::vector<std::string>>(
+      [](const Sort& s) { return s->get_dt_cons_names(); });
 }
 
 uint32_t
 ShadowSort::get_dt_cons_num_sels(const std::string& name) const
 {
-  uint32_t res = d_sort->get_dt_cons_num_sels(name);
-  MURXLA_TEST(res == d_sort_shadow->get_dt_cons_num_sels(name));
-  return res;
+  return get_checked<uint32_t>(
+      [&name](const Sort& s) { return s->get_dt_cons_num_sels(name); });
 }
 
 std::vector<std::string>
 ShadowSort::get_dt_cons_sel_names(const std::string& name) const
 {
-  std::vector<std::string> res = d_sort->get_dt_cons_sel_names(name);
-  MURXLA_TEST(res == d_sort_shadow->get_dt_cons_sel_names(name));
-  return res;
+  return get_checked<std::vector<std::string>>(
+      [&name](const Sort& s) { return s->get_dt_cons_sel_names(name); });
 }
 
 Sort
 ShadowSort::get_array_index_sort() const
 {
-  std::shared_ptr<ShadowSort> res(new ShadowSort(
-      d_sort->get_array_index_sort(), d_sort_shadow->get_array_index_sort()));
-  return res;
+  return get_mapped([](const Sort& s) { return s->get_array_index_sort(); });
 }
 
 Sort
 ShadowSort::get_array_element_sort() const
 {
-  std::shared_ptr<ShadowSort> res(
-      new ShadowSort(d_sort->get_array_element_sort(),
-                     d_sort_shadow->get_array_element_sort()));
-  return res;
+  return get_mapped([](const Sort& s) { return s->get_array_element_sort(); });
 }
 
 Sort
 ShadowSort::get_bag_element_sort() const
 {
-  std::shared_ptr<ShadowSort> res(new ShadowSort(
-      d_sort->get_bag_element_sort(), d_sort_shadow->get_bag_element_sort()));
-  return res;
+  return get_mapped([](const Sort& s) { return s->get_bag_element_sort(); });
 }
 
 uint32_t
 ShadowSort::get_fun_arity() const
 {
-  uint32_t res = d_sort->get_fun_arity();
-  MURXLA_TEST(res == d_sort_shadow->get_fun_arity());
-  return res;
+  return get_checked<uint32_t>(
+      [](const Sort& s) { return s->get_fun_arity(); });
 }
 
 Sort
 ShadowSort::get_fun_codomain_sort() const
 {
-  std::shared_ptr<ShadowSort> res(new ShadowSort(
-      d_sort->get_fun_codomain_sort(), d_sort_shadow->get_fun_codomain_sort()));
-  return res;
+  return get_mapped([](const Sort& s) { return s->get_fun_codomain_sort(); });
 }
 
 std::vector<Sort>
 ShadowSort::get_fun_domain_sorts() const
 {
-  std::vector<Sort> sorts        = d_sort->get_fun_domain_sorts();
-  std::vector<Sort> sorts_shadow = d_sort_shadow->get_fun_domain_sorts();
-  MURXLA_TEST(sorts.size() == sorts_shadow.size());
+  size_t n_solvers = d_backend_sorts.size();
+  std::vector<std::vector<Sort>> sorts(n_solvers);
+  for (size_t i = 0; i < n_solvers; ++i)
+  {
+    if (d_backend_sorts[i])
+    {
+      sorts[i] = d_backend_sorts[i]->get_fun_domain_sorts();
+      MURXLA_TEST(sorts[i].size() == sorts[0].size());
+    }
+  }
   std::vector<Sort> res;
-  for (size_t i = 0, n = sorts.size(); i < n; ++i)
+  for (size_t j = 0, n = sorts[0].size(); j < n; ++j)
   {
-    res.push_back(
-        std::shared_ptr<ShadowSort>(new ShadowSort(sorts[i], sorts_shadow[i])));
+    std::vector<Sort> domain_sorts(n_solvers);
+    for (size_t i = 0; i < n_solvers; ++i)
+    {
+      if (d_backend_sorts[i]) domain_sorts[i] = sorts[i][j];
+    }
+    res.push_back(std::shared_ptr<ShadowSort>(new ShadowSort(domain_sorts)));
   }
   return res;
 }
@@ -260,34 +266,35 @@ ShadowSort::get_fun_domain_sorts() const
 Sort
 ShadowSort::get_seq_element_sort() const
 {
-  std::shared_ptr<ShadowSort> res(new ShadowSort(
-      d_sort->get_seq_element_sort(), d_sort_shadow->get_seq_element_sort()));
-  return res;
+  return get_mapped([](const Sort& s) { return s->get_seq_element_sort(); });
 }
 
 Sort
 ShadowSort::get_set_element_sort() const
 {
-  std::shared_ptr<ShadowSort> res(new ShadowSort(
-      d_sort->get_set_element_sort(), d_sort_shadow->get_set_element_sort()));
-  return res;
+  return get_mapped([](const Sort& s) { return s->get_set_element_sort(); });
 }
 
 void
 ShadowSort::set_kind(SortKind sort_kind)
 {
-  d_sort->set_kind(sort_kind);
-  d_sort_shadow->set_kind(sort_kind);
+  for (auto& s : d_backend_sorts)
+  {
+    if (s) s->set_kind(sort_kind);
+  }
   d_kind = sort_kind;
 }
 
 void
 ShadowSort::set_sorts(const std::vector<Sort>& sorts)
 {
-  std::vector<Sort> sorts_orig, sorts_shadow;
-  ShadowSolver::get_sorts_helper(sorts, sorts_orig, sorts_shadow);
-  d_sort->set_sorts(sorts_orig);
-  d_sort_shadow->set_sorts(sorts_shadow);
+  for (size_t i = 0, n = d_backend_sorts.size(); i < n; ++i)
+  {
+    if (d_backend_sorts[i])
+    {
+      d_backend_sorts[i]->set_sorts(ShadowSolver::get_sorts_helper(sorts, i));
+    }
+  }
   d_sorts = sorts;
 }
 
@@ -295,47 +302,26 @@ void
 ShadowSort::set_associated_sort(Sort sort)
 {
   ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
-  d_sort->set_associated_sort(s->d_sort);
-  d_sort_shadow->set_associated_sort(s->d_sort_shadow);
+  for (size_t i = 0, n = d_backend_sorts.size(); i < n; ++i)
+  {
+    if (d_backend_sorts[i])
+    {
+      d_backend_sorts[i]->set_associated_sort(s->d_backend_sorts[i]);
+    }
+  }
 }
 
 void
 ShadowSort::set_dt_ctors(const DatatypeConstructorMap& ctors)
 {
-  DatatypeConstructorMap ctors_orig, ctors_shadow;
-
-  for (const auto& c : ctors)
+  for (size_t i = 0, n = d_backend_sorts.size(); i < n; ++i)
   {
-    const auto& cname   = c.first;
-    ctors_orig[cname]   = {};
-    ctors_shadow[cname] = {};
-
-    const auto& sels = c.second;
-    for (const auto& s : sels)
+    if (d_backend_sorts[i])
     {
-      const auto& sname  = s.first;
-      auto& sel_sort     = s.second;
-      Sort sel_sort_orig = sel_sort, sel_sort_shadow = sel_sort;
-      if (sel_sort && !sel_sort->is_param_sort())
-      {
-        if (sel_sort->is_unresolved_sort())
-        {
-          ShadowSolver::get_unresolved_sort_helper(
-              sel_sort, sel_sort_orig, sel_sort_shadow);
-        }
-        else
-        {
-          ShadowSort* sort = checked_cast<ShadowSort*>(sel_sort.get());
-          sel_sort_orig    = sort->get_sort();
-          sel_sort_shadow  = sort->get_sort_shadow();
-        }
-      }
-      ctors_orig[cname].emplace_back(sname, sel_sort_orig);
-      ctors_shadow[cname].emplace_back(sname, sel_sort_shadow);
+      d_backend_sorts[i]->set_dt_ctors(
+          ShadowSolver::get_dt_ctors_helper(ctors, i));
     }
   }
-  d_sort->set_dt_ctors(ctors_orig);
-  d_sort_shadow->set_dt_ctors(ctors_shadow);
   d_dt_ctors = ctors;
 }
 
@@ -343,382 +329,451 @@ void
 ShadowSort::set_dt_is_instantiated(bool value)
 {
   AbsSort::set_dt_is_instantiated(value);
-  d_sort->set_dt_is_instantiated(value);
-  d_sort_shadow->set_dt_is_instantiated(value);
+  for (auto& s : d_backend_sorts)
+  {
+    if (s) s->set_dt_is_instantiated(value);
+  }
 }
 
-ShadowTerm::ShadowTerm(Term term, Term term_shadow)
-    : d_term(term), d_term_shadow(term_shadow){};
+Sort
+ShadowSort::get_mapped(const std::function<Sort(const Sort&)>& fun) const
+{
+  std::vector<Sort> res(d_backend_sorts.size());
+  for (size_t i = 0, n = d_backend_sorts.size(); i < n; ++i)
+  {
+    if (d_backend_sorts[i]) res[i] = fun(d_backend_sorts[i]);
+  }
+  return std::shared_ptr<ShadowSort>(new ShadowSort(res));
+}
+
+ShadowTerm::ShadowTerm(const std::vector<Term>& terms) : d_backend_terms(terms)
+{
+  assert(!d_backend_terms.empty());
+  assert(d_backend_terms[0]);
+}
 
 ShadowTerm::~ShadowTerm() {}
 
 size_t
 ShadowTerm::hash() const
 {
-  return d_term->hash() + d_term_shadow->hash();
+  size_t res = 0;
+  for (const auto& t : d_backend_terms)
+  {
+    if (t) res += t->hash();
+  }
+  return res;
 }
+
 bool
 ShadowTerm::equals(const Term& other) const
 {
   ShadowTerm* s_term = checked_cast<ShadowTerm*>(other.get());
   if (s_term)
   {
-    return d_term->equals(s_term->d_term)
-           && d_term_shadow->equals(s_term->d_term_shadow);
+    assert(s_term->d_backend_terms.size() == d_backend_terms.size());
+    for (size_t i = 0, n = d_backend_terms.size(); i < n; ++i)
+    {
+      if (d_backend_terms[i] && s_term->d_backend_terms[i]
+          && !d_backend_terms[i]->equals(s_term->d_backend_terms[i]))
+      {
+        return false;
+      }
+    }
+    return true;
   }
   return false;
 }
+
 std::string
 ShadowTerm::to_string() const
 {
-  return d_term->to_string();
+  return d_backend_terms[0]->to_string();
 }
 
 const Op::Kind&
 ShadowTerm::get_kind() const
 {
-  return d_term->get_kind();
+  return d_backend_terms[0]->get_kind();
 }
 
 bool
 ShadowTerm::is_array() const
 {
-  return d_term->is_array();
+  return d_backend_terms[0]->is_array();
 }
+
 bool
 ShadowTerm::is_bool() const
 {
-  return d_term->is_bool();
+  return d_backend_terms[0]->is_bool();
 }
+
 bool
 ShadowTerm::is_bv() const
 {
-  return d_term->is_bv();
+  return d_backend_terms[0]->is_bv();
 }
+
 bool
 ShadowTerm::is_fp() const
 {
-  return d_term->is_fp();
+  return d_backend_terms[0]->is_fp();
 }
+
 bool
 ShadowTerm::is_fun() const
 {
-  return d_term->is_fun();
+  return d_backend_terms[0]->is_fun();
 }
+
 bool
 ShadowTerm::is_int() const
 {
-  return d_term->is_int();
+  return d_backend_terms[0]->is_int();
 }
+
 bool
 ShadowTerm::is_real() const
 {
-  return d_term->is_real();
+  return d_backend_terms[0]->is_real();
 }
+
 bool
 ShadowTerm::is_rm() const
 {
-  return d_term->is_rm();
+  return d_backend_terms[0]->is_rm();
 }
+
 bool
 ShadowTerm::is_string() const
 {
-  return d_term->is_string();
+  return d_backend_terms[0]->is_string();
 }
+
 bool
 ShadowTerm::is_reglan() const
 {
-  return d_term->is_reglan();
+  return d_backend_terms[0]->is_reglan();
 }
 
 bool
 ShadowTerm::is_bool_value() const
 {
-  return d_term->is_bool_value();
+  return d_backend_terms[0]->is_bool_value();
 }
 
 bool
 ShadowTerm::is_bv_value() const
 {
-  return d_term->is_bv_value();
+  return d_backend_terms[0]->is_bv_value();
 }
 
 bool
 ShadowTerm::is_fp_value() const
 {
-  return d_term->is_fp_value();
+  return d_backend_terms[0]->is_fp_value();
 }
 
 bool
 ShadowTerm::is_int_value() const
 {
-  return d_term->is_int_value();
+  return d_backend_terms[0]->is_int_value();
 }
 
 bool
 ShadowTerm::is_real_value() const
 {
-  return d_term->is_real_value();
+  return d_backend_terms[0]->is_real_value();
 }
 
 bool
 ShadowTerm::is_reglan_value() const
 {
-  return d_term->is_reglan_value();
+  return d_backend_terms[0]->is_reglan_value();
 }
 
 bool
 ShadowTerm::is_rm_value() const
 {
-  return d_term->is_rm_value();
+  return d_backend_terms[0]->is_rm_value();
 }
 
 bool
 ShadowTerm::is_string_value() const
 {
-  return d_term->is_string_value();
+  return d_backend_terms[0]->is_string_value();
 }
 
 bool
 ShadowTerm::is_special_value(const SpecialValueKind& kind) const
 {
-  return d_term->is_special_value(kind);
+  return d_backend_terms[0]->is_special_value(kind);
 }
 
 bool
 ShadowTerm::is_const() const
 {
-  return d_term->is_const();
+  return d_backend_terms[0]->is_const();
 }
 
 void
 ShadowTerm::set_sort(Sort sort)
 {
   AbsTerm::set_sort(sort);
-  Sort sort_orig, sort_shadow;
-  if (sort)
+  for (size_t i = 0, n = d_backend_terms.size(); i < n; ++i)
   {
-    if (sort->is_param_sort())
-    {
-      ShadowSolver::get_param_sort_helper(sort, sort_orig, sort_shadow);
-    }
-    else if (sort->is_unresolved_sort())
-    {
-      ShadowSolver::get_unresolved_sort_helper(sort, sort_orig, sort_shadow);
-    }
-    else
+    if (d_backend_terms[i])
     {
-      ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
-      assert(s);
-      sort_orig   = s->get_sort();
-      sort_shadow = s->get_sort_shadow();
+      d_backend_terms[i]->set_sort(ShadowSolver::get_sort_helper(sort, i));
     }
   }
-  d_term->set_sort(sort_orig);
-  d_term_shadow->set_sort(sort_shadow);
 }
 
 void
 ShadowTerm::set_special_value_kind(const SpecialValueKind& value_kind)
 {
   AbsTerm::set_special_value_kind(value_kind);
-  d_term->set_special_value_kind(value_kind);
-  d_term_shadow->set_special_value_kind(value_kind);
+  for (auto& t : d_backend_terms)
+  {
+    if (t) t->set_special_value_kind(value_kind);
+  }
 }
 
 void
 ShadowTerm::set_leaf_kind(LeafKind kind)
 {
   AbsTerm::set_leaf_kind(kind);
-  d_term->set_leaf_kind(kind);
-  d_term_shadow->set_leaf_kind(kind);
+  for (auto& t : d_backend_terms)
+  {
+    if (t) t->set_leaf_kind(kind);
+  }
 }
 
 ShadowSolver::ShadowSolver(SolverSeedGenerator& sng,
-                           Solver* solver,
-                           Solver* solver_shadow)
+                           const std::vector<Solver*>& solvers,
+                           bool concurrent,
+                           double perf_ratio)
     : Solver(sng),
-      d_solver(solver),
-      d_solver_shadow(solver_shadow),
-      d_same_solver(solver->get_name() == solver_shadow->get_name()){};
+      d_enabled(solvers.size(), true),
+      d_voting(solvers.size() > 2),
+      d_concurrent(concurrent),
+      d_perf_ratio(perf_ratio),
+      d_times(solvers.size(), 0)
+{
+  assert(solvers.size() >= 2);
+  for (Solver* solver : solvers)
+  {
+    d_solvers.emplace_back(solver);
+    d_same_solver =
+        d_same_solver && solver->get_name() == solvers[0]->get_name();
+  }
+}
 
-ShadowSolver::~ShadowSolver(){};
+ShadowSolver::~ShadowSolver() {}
 
-void
-ShadowSolver::get_sorts_helper(const std::vector<Sort>& sorts,
-                               std::vector<Sort>& sorts_orig,
-                               std::vector<Sort>& sorts_shadow)
+Sort
+ShadowSolver::get_sort_helper(Sort sort, size_t i)
 {
-  for (auto s : sorts)
+  if (!sort) return sort;
+
+  if (sort->is_param_sort() || sort->is_unresolved_sort())
   {
-    assert(s);
-    Sort s_orig, s_shadow;
-    if (s->is_param_sort())
-    {
-      get_param_sort_helper(s, s_orig, s_shadow);
-    }
-    else if (s->is_unresolved_sort())
+    Sort res;
+    if (sort->is_param_sort())
     {
-      get_unresolved_sort_helper(s, s_orig, s_shadow);
+      ParamSort* psort = checked_cast<ParamSort*>(sort.get());
+      res = std::shared_ptr<ParamSort>(new ParamSort(psort->get_symbol()));
     }
     else
     {
-      ShadowSort* sort = checked_cast<ShadowSort*>(s.get());
-      assert(sort);
-      s_orig   = sort->get_sort();
-      s_shadow = sort->get_sort_shadow();
+      UnresolvedSort* usort = checked_cast<UnresolvedSort*>(sort.get());
+      res                   = std::shared_ptr<UnresolvedSort>(
+          new UnresolvedSort(usort->get_symbol()));
+      res->set_sorts(get_sorts_helper(usort->get_sorts(), i));
     }
-    sorts_orig.push_back(s_orig);
-    sorts_shadow.push_back(s_shadow);
+    Sort ass = sort->get_associated_sort();
+    assert(!ass || (!ass->is_param_sort() && !ass->is_unresolved_sort()));
+    res->set_associated_sort(get_sort_helper(ass, i));
+    return res;
   }
+
+  ShadowSort* ssort = checked_cast<ShadowSort*>(sort.get());
+  assert(ssort);
+  return ssort->get_sort(i);
 }
 
-void
-ShadowSolver::get_param_sort_helper(Sort sort,
-                                    Sort& sort_orig,
-                                    Sort& sort_shadow)
+std::vector<Sort>
+ShadowSolver::get_sorts_helper(const std::vector<Sort>& sorts, size_t i)
 {
-  assert(sort->is_param_sort());
-
-  ParamSort* psort = checked_cast<ParamSort*>(sort.get());
+  std::vector<Sort> res;
+  for (const auto& s : sorts)
+  {
+    assert(s);
+    res.push_back(get_sort_helper(s, i));
+  }
+  return res;
+}
 
-  sort_orig   = std::shared_ptr<ParamSort>(new ParamSort(psort->get_symbol()));
-  sort_shadow = std::shared_ptr<ParamSort>(new ParamSort(psort->get_symbol()));
+std::vector<Term>
+ShadowSolver::get_terms_helper(const std::vector<Term>& terms, size_t i)
+{
+  std::vector<Term> res;
+  for (const auto& t : terms)
+  {
+    ShadowTerm* term = checked_cast<ShadowTerm*>(t.get());
+    assert(term);
+    res.push_back(term->get_term(i));
+  }
+  return res;
+}
 
-  Sort ass = sort->get_associated_sort();
-  assert(!ass || (!ass->is_param_sort() && !ass->is_unresolved_sort()));
-  Sort ass_orig = ass, ass_shadow = ass;
-  if (ass)
+AbsSort::DatatypeConstructorMap
+ShadowSolver::get_dt_ctors_helper(const AbsSort::DatatypeConstructorMap& ctors,
+                                  size_t i)
+{
+  AbsSort::DatatypeConstructorMap res;
+  for (const auto& [cname, sels] : ctors)
   {
-    if (ass->is_param_sort())
+    res[cname] = {};
+    for (const auto& [sname, sel_sort] : sels)
     {
-      get_param_sort_helper(ass, ass_orig, ass_shadow);
-    }
-    else if (ass->is_unresolved_sort())
-    {
-      get_unresolved_sort_helper(ass, ass_orig, ass_shadow);
-    }
-    else
-    {
-      ShadowSort* sass = checked_cast<ShadowSort*>(ass.get());
-      ass_orig         = sass->get_sort();
-      ass_shadow       = sass->get_sort_shadow();
+      /* Parametric selector sorts are shared between all solvers. */
+      Sort sel_sort_i = sel_sort;
+      if (sel_sort && !sel_sort->is_param_sort())
+      {
+        sel_sort_i = get_sort_helper(sel_sort, i);
+      }
+      res[cname].emplace_back(sname, sel_sort_i);
     }
   }
-  sort_orig->set_associated_sort(ass_orig);
-  sort_shadow->set_associated_sort(ass_shadow);
+  return res;
 }
 
 void
-ShadowSolver::get_unresolved_sort_helper(Sort sort,
-                                         Sort& sort_orig,
-                                         Sort& sort_shadow)
+ShadowSolver::for_each_solver(const std::function<void(size_t)>& fun)
 {
-  UnresolvedSort* usort = checked_cast<UnresolvedSort*>(sort.get());
-
-  sort_orig =
-      std::shared_ptr<UnresolvedSort>(new UnresolvedSort(usort->get_symbol()));
-  sort_shadow =
-      std::shared_ptr<UnresolvedSort>(new UnresolvedSort(usort->get_symbol()));
+  call_solvers<bool>([&fun](size_t i) {
+    fun(i);
+    return true;
+  });
+}
 
-  Sort ass = sort->get_associated_sort();
-  assert(!ass || (!ass->is_param_sort() && !ass->is_unresolved_sort()));
-  Sort ass_orig = ass, ass_shadow = ass;
-  if (ass)
+Solver::Result
+ShadowSolver::vote(const std::vector<Result>& results) const
+{
+  std::vector<size_t> sat, unsat;
+  for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
   {
-    if (ass->is_param_sort())
-    {
-      get_param_sort_helper(ass, ass_orig, ass_shadow);
-    }
-    else if (ass->is_unresolved_sort())
+    if (!d_enabled[i]) continue;
+    if (results[i] == Result::SAT)
     {
-      get_unresolved_sort_helper(ass, ass_orig, ass_shadow);
+      sat.push_back(i);
     }
-    else
+    else if (results[i] == Result::UNSAT)
     {
-      ShadowSort* sass = checked_cast<ShadowSort*>(ass.get());
-      ass_orig         = sass->get_sort();
-      ass_shadow       = sass->get_sort_shadow();
+      unsat.push_back(i);
     }
   }
-  sort_orig->set_associated_sort(ass_orig);
-  sort_shadow->set_associated_sort(ass_shadow);
 
-  std::vector<Sort> inst_sorts_orig, inst_sorts_shadow;
-  for (Sort isort : usort->get_sorts())
+  if (!sat.empty() && !unsat.empty())
   {
-    Sort isort_orig, isort_shadow;
-    if (isort->is_param_sort())
-    {
-      get_param_sort_helper(isort, isort_orig, isort_shadow);
-    }
-    else if (isort->is_unresolved_sort())
-    {
-      get_unresolved_sort_helper(isort, isort_orig, isort_shadow);
-    }
-    else
-    {
-      ShadowSort* issort = checked_cast<ShadowSort*>(isort.get());
-      isort_orig         = issort->get_sort();
-      isort_shadow       = issort->get_sort_shadow();
-    }
-    inst_sorts_orig.push_back(isort_orig);
-    inst_sorts_shadow.push_back(isort_shadow);
+    auto print = [this](std::stringstream& ss,
+                        const std::vector<size_t>& indices) {
+      for (size_t i = 0, n = indices.size(); i < n; ++i)
+      {
+        ss << (i > 0 ? ", " : "") << d_solvers[indices[i]]->get_name();
+      }
+    };
+    /* On a tie, the solver under test is considered to be in the minority. */
+    bool sat_minority =
+        sat.size() < unsat.size()
+        || (sat.size() == unsat.size() && results[0] == Result::SAT);
+    const auto& minority = sat_minority ? sat : unsat;
+    const auto& majority = sat_minority ? unsat : sat;
+    MURXLA_TEST(d_voting) << "Solver reports " << results[0]
+                          << " while cross-check solver reports "
+                          << results[1];
+    std::stringstream ss_minority, ss_majority;
+    print(ss_minority, minority);
+    print(ss_majority, majority);
+    MURXLA_TEST(false) << "Solver(s) " << ss_minority.str() << " report "
+                       << results[minority[0]] << " while majority ("
+                       << ss_majority.str() << ") reports "
+                       << results[majority[0]];
   }
-  sort_orig->set_sorts(inst_sorts_orig);
-  sort_shadow->set_sorts(inst_sorts_shadow);
+  return results[0];
 }
 
 void
-ShadowSolver::get_terms_helper(const std::vector<Term>& terms,
-                               std::vector<Term>& terms_orig,
-                               std::vector<Term>& terms_shadow)
+ShadowSolver::check_perf(const std::string& action) const
 {
-  for (auto t : terms)
+  if (d_perf_ratio == 0 || d_times[0] < MURXLA_PERF_RATIO_MIN_TIME) return;
+
+  size_t fastest = 0;
+  for (size_t i = 1, n = d_solvers.size(); i < n; ++i)
   {
-    ShadowTerm* term = checked_cast<ShadowTerm*>(t.get());
-    assert(term);
-    terms_orig.push_back(term->get_term());
-    terms_shadow.push_back(term->get_term_shadow());
+    if (d_enabled[i] && (fastest == 0 || d_times[i] < d_times[fastest]))
+    {
+      fastest = i;
+    }
+  }
+  if (fastest > 0)
+  {
+    MURXLA_TEST(d_times[0] <= d_perf_ratio * d_times[fastest])
+        << "performance anomaly: '" << action << "' took " << d_times[0]
+        << "s, " << d_solvers[fastest]->get_name() << " took "
+        << d_times[fastest] << "s, ratio limit is " << d_perf_ratio;
   }
 }
 
 void
 ShadowSolver::new_solver()
 {
-  d_solver->new_solver();
-  d_solver_shadow->new_solver();
+  for (auto& s : d_solvers)
+  {
+    s->new_solver();
+  }
 }
 
 void
 ShadowSolver::delete_solver()
 {
-  d_solver->delete_solver();
-  d_solver_shadow->delete_solver();
-  d_solver.reset(nullptr);
-  d_solver_shadow.reset(nullptr);
+  for (auto& s : d_solvers)
+  {
+    s->delete_solver();
+    s.reset(nullptr);
+  }
 }
 
 bool
 ShadowSolver::is_initialized() const
 {
-  bool res = d_solver->is_initialized();
-  assert(d_solver_shadow->is_initialized() == res);
-  return res;
+  return d_solvers[0]->is_initialized();
 }
 
 const std::string
 ShadowSolver::get_name() const
 {
-  return "ShadowSolver(" + d_solver->get_name() + ","
-         + d_solver_shadow->get_name() + ")";
+  std::stringstream ss;
+  ss << "ShadowSolver(";
+  for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+  {
+    ss << (i > 0 ? "," : "") << d_solvers[i]->get_name();
+  }
+  ss << ")";
+  return ss.str();
 }
 
 const std::string
 ShadowSolver::get_profile() const
 {
-  return SolverProfile::merge(d_solver->get_profile(),
-                              d_solver_shadow->get_profile());
+  std::string res = d_solvers[0]->get_profile();
+  for (size_t i = 1, n = d_solvers.size(); i < n; ++i)
+  {
+    res = SolverProfile::merge(res, d_solvers[i]->get_profile());
+  }
+  return res;
 }
 
 Term
@@ -726,10 +781,9 @@ ShadowSolver::mk_var(Sort sort, const std::string& name)
 {
   ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
   assert(s);
-  Term t        = d_solver->mk_var(s->d_sort, name);
-  Term t_shadow = d_solver_shadow->mk_var(s->d_sort_shadow, name);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>(
+      [&](size_t i) { return d_solvers[i]->mk_var(s->get_sort(i), name); });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -737,10 +791,9 @@ ShadowSolver::mk_const(Sort sort, const std::string& name)
 {
   ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
   assert(s);
-  Term t        = d_solver->mk_const(s->d_sort, name);
-  Term t_shadow = d_solver_shadow->mk_const(s->d_sort_shadow, name);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>(
+      [&](size_t i) { return d_solvers[i]->mk_const(s->get_sort(i), name); });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -750,13 +803,11 @@ ShadowSolver::mk_fun(const std::string& name,
 {
   ShadowTerm* term = checked_cast<ShadowTerm*>(body.get());
   assert(term);
-  std::vector<Term> terms_orig, terms_shadow;
-  get_terms_helper(args, terms_orig, terms_shadow);
-  Term t = d_solver->mk_fun(name, terms_orig, term->get_term());
-  Term t_shadow =
-      d_solver_shadow->mk_fun(name, terms_shadow, term->get_term_shadow());
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>([&](size_t i) {
+    return d_solvers[i]->mk_fun(
+        name, get_terms_helper(args, i), term->get_term(i));
+  });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -764,10 +815,9 @@ ShadowSolver::mk_value(Sort sort, bool value)
 {
   ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
   assert(s);
-  Term t        = d_solver->mk_value(s->d_sort, value);
-  Term t_shadow = d_solver_shadow->mk_value(s->d_sort_shadow, value);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>(
+      [&](size_t i) { return d_solvers[i]->mk_value(s->get_sort(i), value); });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -775,10 +825,9 @@ ShadowSolver::mk_value(Sort sort, const std::string& value)
 {
   ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
   assert(s);
-  Term t        = d_solver->mk_value(s->d_sort, value);
-  Term t_shadow = d_solver_shadow->mk_value(s->d_sort_shadow, value);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>(
+      [&](size_t i) { return d_solvers[i]->mk_value(s->get_sort(i), value); });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -788,10 +837,10 @@ ShadowSolver::mk_value(Sort sort,
 {
   ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
   assert(s);
-  Term t        = d_solver->mk_value(s->d_sort, num, den);
-  Term t_shadow = d_solver_shadow->mk_value(s->d_sort_shadow, num, den);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>([&](size_t i) {
+    return d_solvers[i]->mk_value(s->get_sort(i), num, den);
+  });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -799,10 +848,10 @@ ShadowSolver::mk_value(Sort sort, const std::string& value, Base base)
 {
   ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
   assert(s);
-  Term t        = d_solver->mk_value(s->d_sort, value, base);
-  Term t_shadow = d_solver_shadow->mk_value(s->d_sort_shadow, value, base);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>([&](size_t i) {
+    return d_solvers[i]->mk_value(s->get_sort(i), value, base);
+  });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -811,57 +860,51 @@ ShadowSolver::mk_special_value(Sort sort,
 {
   ShadowSort* s = checked_cast<ShadowSort*>(sort.get());
   assert(s);
-  Term t        = d_solver->mk_special_value(s->d_sort, value);
-  Term t_shadow = d_solver_shadow->mk_special_value(s->d_sort_shadow, value);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>([&](size_t i) {
+    return d_solvers[i]->mk_special_value(s->get_sort(i), value);
+  });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Sort
 ShadowSolver::mk_sort(const std::string& name)
 {
-  Sort s        = d_solver->mk_sort(name);
-  Sort s_shadow = d_solver_shadow->mk_sort(name);
-  std::shared_ptr<ShadowSort> res(new ShadowSort(s, s_shadow));
-  return res;
+  std::vector<Sort> sorts = call_solvers<Sort>(
+      [&](size_t i) { return d_solvers[i]->mk_sort(name); });
+  return std::shared_ptr<ShadowSort>(new ShadowSort(sorts));
 }
 
 Sort
 ShadowSolver::mk_sort(SortKind kind)
 {
-  Sort s        = d_solver->mk_sort(kind);
-  Sort s_shadow = d_solver_shadow->mk_sort(kind);
-  std::shared_ptr<ShadowSort> res(new ShadowSort(s, s_shadow));
-  return res;
+  std::vector<Sort> sorts = call_solvers<Sort>(
+      [&](size_t i) { return d_solvers[i]->mk_sort(kind); });
+  return std::shared_ptr<ShadowSort>(new ShadowSort(sorts));
 }
 
 Sort
 ShadowSolver::mk_sort(SortKind kind, uint32_t size)
 {
-  Sort s        = d_solver->mk_sort(kind, size);
-  Sort s_shadow = d_solver_shadow->mk_sort(kind, size);
-  std::shared_ptr<ShadowSort> res(new ShadowSort(s, s_shadow));
-  return res;
+  std::vector<Sort> sorts = call_solvers<Sort>(
+      [&](size_t i) { return d_solvers[i]->mk_sort(kind, size); });
+  return std::shared_ptr<ShadowSort>(new ShadowSort(sorts));
 }
 
 Sort
 ShadowSolver::mk_sort(SortKind kind, uint32_t esize, uint32_t ssize)
 {
-  Sort s        = d_solver->mk_sort(kind, esize, ssize);
-  Sort s_shadow = d_solver_shadow->mk_sort(kind, esize, ssize);
-  std::shared_ptr<ShadowSort> res(new ShadowSort(s, s_shadow));
-  return res;
+  std::vector<Sort> sorts = call_solvers<Sort>(
+      [&](size_t i) { return d_solvers[i]->mk_sort(kind, esize, ssize); });
+  return std::shared_ptr<ShadowSort>(new ShadowSort(sorts));
 }
 
 Sort
 ShadowSolver::mk_sort(SortKind kind, const std::vector<Sort>& sorts)
 {
-  std::vector<Sort> sorts_orig, sorts_shadow;
-  get_sorts_helper(sorts, sorts_orig, sorts_shadow);
-  Sort s        = d_solver->mk_sort(kind, sorts_orig);
-  Sort s_shadow = d_solver_shadow->mk_sort(kind, sorts_shadow);
-  std::shared_ptr<ShadowSort> res(new ShadowSort(s, s_shadow));
-  return res;
+  std::vector<Sort> res = call_solvers<Sort>([&](size_t i) {
+    return d_solvers[i]->mk_sort(kind, get_sorts_helper(sorts, i));
+  });
+  return std::shared_ptr<ShadowSort>(new ShadowSort(res));
 }
 
 std::vector<Sort>
@@ -874,60 +917,29 @@ ShadowSolver::mk_sort(
   size_t n_dt_sorts = dt_names.size();
   assert(n_dt_sorts == param_sorts.size());
   assert(n_dt_sorts == constructors.size());
-  std::vector<std::vector<Sort>> param_sorts_orig;
-  std::vector<std::vector<Sort>> param_sorts_shadow;
-  std::vector<AbsSort::DatatypeConstructorMap> constructors_orig;
-  std::vector<AbsSort::DatatypeConstructorMap> constructors_shadow;
-
-  for (size_t i = 0; i < n_dt_sorts; ++i)
-  {
-    AbsSort::DatatypeConstructorMap ctors_orig;
-    AbsSort::DatatypeConstructorMap ctors_shadow;
-    for (const auto& c : constructors[i])
-    {
-      const auto& cname   = c.first;
-      const auto& sels    = c.second;
-      ctors_orig[cname]   = {};
-      ctors_shadow[cname] = {};
 
-      for (const auto& s : sels)
-      {
-        const auto& sname  = s.first;
-        auto& sel_sort     = s.second;
-        Sort sel_sort_orig = sel_sort, sel_sort_shadow = sel_sort;
-        if (sel_sort && !sel_sort->is_param_sort())
+  std::vector<std::vector<Sort>> sorts =
+      call_solvers<std::vector<Sort>>([&](size_t i) {
+        std::vector<AbsSort::DatatypeConstructorMap> ctors;
+        for (const auto& c : constructors)
         {
-          if (sel_sort->is_unresolved_sort())
-          {
-            get_unresolved_sort_helper(
-                sel_sort, sel_sort_orig, sel_sort_shadow);
-          }
-          else
-          {
-            ShadowSort* sort = checked_cast<ShadowSort*>(sel_sort.get());
-            sel_sort_orig    = sort->get_sort();
-            sel_sort_shadow  = sort->get_sort_shadow();
-          }
+          ctors.push_back(get_dt_ctors_helper(c, i));
         }
-        ctors_orig[cname].emplace_back(sname, sel_sort_orig);
-        ctors_shadow[cname].emplace_back(sname, sel_sort_shadow);
-      }
-    }
-    constructors_orig.push_back(ctors_orig);
-    constructors_shadow.push_back(ctors_shadow);
-  }
+        std::vector<Sort> res =
+            d_solvers[i]->mk_sort(kind, dt_names, param_sorts, ctors);
+        MURXLA_TEST(res.size() == n_dt_sorts);
+        return res;
+      });
 
-  std::vector<Sort> res_orig =
-      d_solver->mk_sort(kind, dt_names, param_sorts, constructors_orig);
-  std::vector<Sort> res_shadow = d_solver_shadow->mk_sort(
-      kind, dt_names, param_sorts, constructors_shadow);
-  MURXLA_TEST(res_orig.size() == n_dt_sorts);
-  MURXLA_TEST(res_orig.size() == res_shadow.size());
   std::vector<Sort> res;
-  for (size_t i = 0; i < n_dt_sorts; ++i)
+  for (size_t j = 0; j < n_dt_sorts; ++j)
   {
-    res.push_back(std::shared_ptr<ShadowSort>(
-        new ShadowSort(res_orig[i], res_shadow[i])));
+    std::vector<Sort> dt_sorts(d_solvers.size());
+    for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+    {
+      if (!sorts[i].empty()) dt_sorts[i] = sorts[i][j];
+    }
+    res.push_back(std::shared_ptr<ShadowSort>(new ShadowSort(dt_sorts)));
   }
   return res;
 }
@@ -935,18 +947,12 @@ ShadowSolver::mk_sort(
 Sort
 ShadowSolver::instantiate_sort(Sort param_sort, const std::vector<Sort>& sorts)
 {
-  ShadowSort* sort       = checked_cast<ShadowSort*>(param_sort.get());
-  Sort param_sort_orig   = sort->get_sort();
-  Sort param_sort_shadow = sort->get_sort_shadow();
-
-  std::vector<Sort> sorts_orig, sorts_shadow;
-  get_sorts_helper(sorts, sorts_orig, sorts_shadow);
-
-  Sort s_orig   = d_solver->instantiate_sort(param_sort_orig, sorts_orig);
-  Sort s_shadow = d_solver->instantiate_sort(param_sort_shadow, sorts_shadow);
-
-  std::shared_ptr<ShadowSort> res(new ShadowSort(s_orig, s_shadow));
-  return res;
+  ShadowSort* sort = checked_cast<ShadowSort*>(param_sort.get());
+  std::vector<Sort> res = call_solvers<Sort>([&](size_t i) {
+    return d_solvers[i]->instantiate_sort(sort->get_sort(i),
+                                          get_sorts_helper(sorts, i));
+  });
+  return std::shared_ptr<ShadowSort>(new ShadowSort(res));
 }
 
 Term
@@ -954,12 +960,10 @@ ShadowSolver::mk_term(const Op::Kind& kind,
                       const std::vector<Term>& args,
                       const std::vector<uint32_t>& indices)
 {
-  std::vector<Term> terms_orig, terms_shadow;
-  get_terms_helper(args, terms_orig, terms_shadow);
-  Term t        = d_solver->mk_term(kind, terms_orig, indices);
-  Term t_shadow = d_solver_shadow->mk_term(kind, terms_shadow, indices);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>([&](size_t i) {
+    return d_solvers[i]->mk_term(kind, get_terms_helper(args, i), indices);
+  });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -967,12 +971,10 @@ ShadowSolver::mk_term(const Op::Kind& kind,
                       const std::vector<std::string>& str_args,
                       const std::vector<Term>& args)
 {
-  std::vector<Term> terms_orig, terms_shadow;
-  get_terms_helper(args, terms_orig, terms_shadow);
-  Term t        = d_solver->mk_term(kind, str_args, terms_orig);
-  Term t_shadow = d_solver_shadow->mk_term(kind, str_args, terms_shadow);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>([&](size_t i) {
+    return d_solvers[i]->mk_term(kind, str_args, get_terms_helper(args, i));
+  });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Term
@@ -982,15 +984,11 @@ ShadowSolver::mk_term(const Op::Kind& kind,
                       const std::vector<Term>& args)
 {
   ShadowSort* s_sort = checked_cast<ShadowSort*>(sort.get());
-  Sort sort_orig     = s_sort->get_sort();
-  Sort sort_shadow   = s_sort->get_sort_shadow();
-  std::vector<Term> terms_orig, terms_shadow;
-  get_terms_helper(args, terms_orig, terms_shadow);
-  Term t = d_solver->mk_term(kind, sort_orig, str_args, terms_orig);
-  Term t_shadow =
-      d_solver_shadow->mk_term(kind, sort_shadow, str_args, terms_shadow);
-  std::shared_ptr<ShadowTerm> res(new ShadowTerm(t, t_shadow));
-  return res;
+  std::vector<Term> terms = call_solvers<Term>([&](size_t i) {
+    return d_solvers[i]->mk_term(
+        kind, s_sort->get_sort(i), str_args, get_terms_helper(args, i));
+  });
+  return std::shared_ptr<ShadowTerm>(new ShadowTerm(terms));
 }
 
 Sort
@@ -998,62 +996,86 @@ ShadowSolver::get_sort(Term term, SortKind sort_kind)
 {
   ShadowTerm* t = checked_cast<ShadowTerm*>(term.get());
   assert(t);
-  Sort s        = d_solver->get_sort(t->get_term(), sort_kind);
-  Sort s_shadow = d_solver_shadow->get_sort(t->get_term_shadow(), sort_kind);
-  std::shared_ptr<ShadowSort> res(new ShadowSort(s, s_shadow));
-  return res;
+  std::vector<Sort> sorts = call_solvers<Sort>([&](size_t i) {
+    return d_solvers[i]->get_sort(t->get_term(i), sort_kind);
+  });
+  return std::shared_ptr<ShadowSort>(new ShadowSort(sorts));
 }
 
 std::string
 ShadowSolver::get_option_name_incremental() const
 {
-  return d_solver->get_option_name_incremental();
+  return d_solvers[0]->get_option_name_incremental();
 }
 
 std::string
 ShadowSolver::get_option_name_model_gen() const
 {
-  return d_solver->get_option_name_model_gen();
+  return d_solvers[0]->get_option_name_model_gen();
 }
 
 std::string
 ShadowSolver::get_option_name_unsat_assumptions() const
 {
-  return d_solver->get_option_name_unsat_assumptions();
+  return d_solvers[0]->get_option_name_unsat_assumptions();
 }
 
 std::string
 ShadowSolver::get_option_name_unsat_cores() const
 {
-  return d_solver->get_option_name_unsat_cores();
+  return d_solvers[0]->get_option_name_unsat_cores();
 }
 
 bool
 ShadowSolver::option_incremental_enabled() const
 {
-  return d_solver->option_incremental_enabled()
-         && d_solver_shadow->option_incremental_enabled();
+  for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+  {
+    if (d_enabled[i] && !d_solvers[i]->option_incremental_enabled())
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool
 ShadowSolver::option_model_gen_enabled() const
 {
-  return d_solver->option_model_gen_enabled()
-         && d_solver_shadow->option_model_gen_enabled();
+  for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+  {
+    if (d_enabled[i] && !d_solvers[i]->option_model_gen_enabled())
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool
 ShadowSolver::option_unsat_assumptions_enabled() const
 {
-  return d_solver->option_unsat_assumptions_enabled()
-         && d_solver_shadow->option_unsat_assumptions_enabled();
+  for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+  {
+    if (d_enabled[i] && !d_solvers[i]->option_unsat_assumptions_enabled())
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool
 ShadowSolver::option_unsat_cores_enabled() const
 {
-  return d_solver->option_unsat_cores_enabled()
-         && d_solver_shadow->option_unsat_cores_enabled();
+  for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+  {
+    if (d_enabled[i] && !d_solvers[i]->option_unsat_cores_enabled())
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool
@@ -1061,11 +1083,14 @@ ShadowSolver::is_unsat_assumption(const Term& t) const
 {
   ShadowTerm* term = checked_cast<ShadowTerm*>(t.get());
   assert(term);
-  bool res = d_solver->is_unsat_assumption(term->get_term());
+  bool res = d_solvers[0]->is_unsat_assumption(term->get_term(0));
   if (d_same_solver)
   {
-    assert(res
-           == d_solver_shadow->is_unsat_assumption(term->get_term_shadow()));
+    for (size_t i = 1, n = d_solvers.size(); i < n; ++i)
+    {
+      assert(!d_enabled[i]
+             || res == d_solvers[i]->is_unsat_assumption(term->get_term(i)));
+    }
   }
   return res;
 }
@@ -1075,51 +1100,50 @@ ShadowSolver::assert_formula(const Term& t)
 {
   ShadowTerm* term = checked_cast<ShadowTerm*>(t.get());
   assert(term);
-  d_solver->assert_formula(term->get_term());
-  d_solver_shadow->assert_formula(term->get_term_shadow());
+  for_each_solver(
+      [&](size_t i) { d_solvers[i]->assert_formula(term->get_term(i)); });
 }
 
 Solver::Result
 ShadowSolver::check_sat()
 {
-  Result res_orig   = d_solver->check_sat();
-  Result res_shadow = d_solver_shadow->check_sat();
-  if (res_orig != Result::UNKNOWN && res_shadow != Result::UNKNOWN)
-  {
-    MURXLA_TEST(res_orig == res_shadow)
-        << "Solver reports " << res_orig << " while cross-check solver reports "
-        << res_shadow;
-  }
-  return res_orig;
+  Result res = vote(call_solvers<Result>(
+      [this](size_t i) { return d_solvers[i]->check_sat(); }, true));
+  check_perf(ActionCheckSat::s_name);
+  return res;
 }
 
 Solver::Result
 ShadowSolver::check_sat_assuming(const std::vector<Term>& assumptions)
 {
-  std::vector<Term> assumptions_orig, assumptions_shadow;
-  get_terms_helper(assumptions, assumptions_orig, assumptions_shadow);
-  Result res_orig   = d_solver->check_sat_assuming(assumptions_orig);
-  Result res_shadow = d_solver_shadow->check_sat_assuming(assumptions_shadow);
-  if (res_orig != Result::UNKNOWN && res_shadow != Result::UNKNOWN)
-  {
-    MURXLA_TEST(res_orig == res_shadow)
-        << "Solver reports " << res_orig << " while cross-check solver reports "
-        << res_shadow;
-  }
-  return res_orig;
+  Result res = vote(call_solvers<Result>(
+      [&](size_t i) {
+        return d_solvers[i]->check_sat_assuming(
+            get_terms_helper(assumptions, i));
+      },
+      true));
+  check_perf(ActionCheckSatAssuming::s_name);
+  return res;
 }
 
 std::vector<Term>
 ShadowSolver::get_unsat_assumptions()
 {
   assert(d_same_solver);
-  std::vector<Term> res, terms, terms_shadow;
-  auto ua_orig   = d_solver->get_unsat_assumptions();
-  auto ua_shadow = d_solver_shadow->get_unsat_assumptions();
-  assert(ua_orig.size() == ua_shadow.size());
-  for (size_t i = 0; i < ua_orig.size(); ++i)
+  std::vector<std::vector<Term>> terms = call_solvers<std::vector<Term>>(
+      [this](size_t i) { return d_solvers[i]->get_unsat_assumptions(); },
+      true);
+  std::vector<Term> res;
+  for (size_t j = 0, size = terms[0].size(); j < size; ++j)
   {
-    res.emplace_back(new ShadowTerm(ua_orig[i], ua_shadow[i]));
+    std::vector<Term> ua(d_solvers.size());
+    for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+    {
+      if (!d_enabled[i]) continue;
+      MURXLA_TEST(terms[i].size() == size);
+      ua[i] = terms[i][j];
+    }
+    res.emplace_back(new ShadowTerm(ua));
   }
   return res;
 }
@@ -1128,13 +1152,19 @@ std::vector<Term>
 ShadowSolver::get_unsat_core()
 {
   assert(d_same_solver);
-  std::vector<Term> res, terms, terms_shadow;
-  auto uc_orig   = d_solver->get_unsat_core();
-  auto uc_shadow = d_solver_shadow->get_unsat_core();
-  assert(uc_orig.size() == uc_shadow.size());
-  for (size_t i = 0; i < uc_orig.size(); ++i)
+  std::vector<std::vector<Term>> terms = call_solvers<std::vector<Term>>(
+      [this](size_t i) { return d_solvers[i]->get_unsat_core(); }, true);
+  std::vector<Term> res;
+  for (size_t j = 0, size = terms[0].size(); j < size; ++j)
   {
-    res.emplace_back(new ShadowTerm(uc_orig[i], uc_shadow[i]));
+    std::vector<Term> uc(d_solvers.size());
+    for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+    {
+      if (!d_enabled[i]) continue;
+      MURXLA_TEST(terms[i].size() == size);
+      uc[i] = terms[i][j];
+    }
+    res.emplace_back(new ShadowTerm(uc));
   }
   return res;
 }
@@ -1142,77 +1172,94 @@ ShadowSolver::get_unsat_core()
 void
 ShadowSolver::push(uint32_t n_levels)
 {
-  d_solver->push(n_levels);
-  d_solver_shadow->push(n_levels);
+  for_each_solver([&](size_t i) { d_solvers[i]->push(n_levels); });
 }
 
 void
 ShadowSolver::pop(uint32_t n_levels)
 {
-  d_solver->pop(n_levels);
-  d_solver_shadow->pop(n_levels);
+  for_each_solver([&](size_t i) { d_solvers[i]->pop(n_levels); });
 }
 
 void
 ShadowSolver::print_model()
 {
-  d_solver->print_model();
-  d_solver_shadow->print_model();
+  for_each_solver([this](size_t i) { d_solvers[i]->print_model(); });
 }
 
 void
 ShadowSolver::reset()
 {
-  d_solver->reset();
-  d_solver_shadow->reset();
+  for_each_solver([this](size_t i) { d_solvers[i]->reset(); });
 }
 
 void
 ShadowSolver::reset_assertions()
 {
-  d_solver->reset_assertions();
-  d_solver_shadow->reset_assertions();
+  for_each_solver([this](size_t i) { d_solvers[i]->reset_assertions(); });
 }
 
 void
 ShadowSolver::set_opt(const std::string& opt, const std::string& value)
 {
+  /* Options with the check solver prefix are options of the shadow solvers.
+   * All other options are options of the solver under test, only options
+   * that murxla keeps track of are passed on to the shadow solvers. */
   const std::string shadow_prefix = MURXLA_CHECK_SOLVER_OPT_PREFIX;
-  if (opt.find(shadow_prefix, 0) == 0)
-  {
-    std::string name(opt.begin() + shadow_prefix.size(), opt.end());
-    d_solver_shadow->set_opt(name, value);
-  }
-  else
+  bool is_shadow_opt              = opt.find(shadow_prefix, 0) == 0;
+  if (!is_shadow_opt)
   {
-    d_solver->set_opt(opt, value);
+    d_solvers[0]->set_opt(opt, value);
   }
 
-  if (opt == d_solver->get_option_name_incremental())
-  {
-    d_solver_shadow->set_opt(d_solver_shadow->get_option_name_incremental(),
-                             value);
-  }
-  else if (opt == d_solver->get_option_name_model_gen())
-  {
-    d_solver_shadow->set_opt(d_solver_shadow->get_option_name_model_gen(),
-                             value);
-  }
-  else if (opt == d_solver->get_option_name_unsat_assumptions())
+  for (size_t i = 1, n = d_solvers.size(); i < n; ++i)
   {
-    d_solver_shadow->set_opt(
-        d_solver_shadow->get_option_name_unsat_assumptions(), value);
+    if (!d_enabled[i]) continue;
+    Solver* solver = d_solvers[i].get();
+    std::string name;
+    if (is_shadow_opt)
+    {
+      name = opt.substr(shadow_prefix.size());
+    }
+    else if (opt == d_solvers[0]->get_option_name_incremental())
+    {
+      name = solver->get_option_name_incremental();
+    }
+    else if (opt == d_solvers[0]->get_option_name_model_gen())
+    {
+      name = solver->get_option_name_model_gen();
+    }
+    else if (opt == d_solvers[0]->get_option_name_unsat_assumptions())
+    {
+      name = solver->get_option_name_unsat_assumptions();
+    }
+    else if (opt == d_solvers[0]->get_option_name_unsat_cores())
+    {
+      name = solver->get_option_name_unsat_cores();
+    }
+    if (name.empty()) continue;
+    try
+    {
+      solver->set_opt(name, value);
+    }
+    catch (const MurxlaSolverOptionException& e)
+    {
+      if (!d_voting) throw;
+      d_enabled[i] = false;
+    }
   }
 }
 
 std::unordered_map<std::string, std::string>
 ShadowSolver::get_required_options(Theory theory) const
 {
-  auto req_opts = d_solver->get_required_options(theory);
-
-  for (const auto& [name, val] : d_solver_shadow->get_required_options(theory))
+  auto req_opts = d_solvers[0]->get_required_options(theory);
+  for (size_t i = 1, n = d_solvers.size(); i < n; ++i)
   {
-    req_opts.emplace(MURXLA_CHECK_SOLVER_OPT_PREFIX + name, val);
+    for (const auto& [name, val] : d_solvers[i]->get_required_options(theory))
+    {
+      req_opts.emplace(MURXLA_CHECK_SOLVER_OPT_PREFIX + name, val);
+    }
   }
   return req_opts;
 }
@@ -1221,14 +1268,22 @@ std::vector<Term>
 ShadowSolver::get_value(const std::vector<Term>& terms)
 {
   assert(d_same_solver);
-  std::vector<Term> res, terms_orig, terms_shadow;
-  get_terms_helper(terms, terms_orig, terms_shadow);
-  auto values_orig   = d_solver->get_value(terms_orig);
-  auto values_shadow = d_solver_shadow->get_value(terms_shadow);
-  assert(values_orig.size() == values_shadow.size());
-  for (size_t i = 0; i < values_orig.size(); ++i)
+  std::vector<std::vector<Term>> values = call_solvers<std::vector<Term>>(
+      [&](size_t i) {
+        return d_solvers[i]->get_value(get_terms_helper(terms, i));
+      },
+      true);
+  std::vector<Term> res;
+  for (size_t j = 0, size = values[0].size(); j < size; ++j)
   {
-    res.emplace_back(new ShadowTerm(values_orig[i], values_shadow[i]));
+    std::vector<Term> vals(d_solvers.size());
+    for (size_t i = 0, n = d_solvers.size(); i < n; ++i)
+    {
+      if (!d_enabled[i]) continue;
+      MURXLA_TEST(values[i].size() == size);
+      vals[i] = values[i][j];
+    }
+    res.emplace_back(new ShadowTerm(vals));
   }
   return res;
 }
@@ -1236,9 +1291,12 @@ ShadowSolver::get_value(const std::vector<Term>& terms)
 void
 ShadowSolver::disable_unsupported_actions(FSM* fsm) const
 {
-  d_solver->disable_unsupported_actions(fsm);
-  d_solver_shadow->disable_unsupported_actions(fsm);
+  for (const auto& s : d_solvers)
+  {
+    s->disable_unsupported_actions(fsm);
+  }
 
+  /* Models and cores of different solvers are not comparable. */
   if (!d_same_solver)
   {
     fsm->disable_action(ActionGetValue::s_name);
@@ -10,20 +10,32 @@
 #ifndef __MURXLA__SHADOW_SOLVER_H
 #define __MURXLA__SHADOW_SOLVER_H
 
+#include <functional>
+#include <future>
+
+#include "except.hpp"
 #include "fsm.hpp"
 #include "solver/solver.hpp"
 #include "theory.hpp"
+#include "util.hpp"
 
 namespace murxla {
 namespace shadow {
 
+/**
+ * The sort of a ShadowSolver, wraps one sort per backend solver.
+ *
+ * The sort of a backend that was disabled before the sort was created is
+ * nullptr.  All queries are answered by the solver under test (backend 0),
+ * and checked against all other backends.
+ */
 class ShadowSort : public AbsSort
 {
   friend class ShadowTerm;
   friend class ShadowSolver;
 
  public:
-  ShadowSort(Sort sort, Sort sort_shadow);
+  ShadowSort(const std::vector<Sort>& sorts);
   ~ShadowSort() override;
   size_t hash() const override;
   bool equals(const Sort& other) const override;
@@ -68,20 +80,45 @@ class ShadowSort : public AbsSort
   void set_dt_ctors(const DatatypeConstructorMap& ctors) override;
   void set_dt_is_instantiated(bool value) override;
 
-  Sort get_sort() const { return d_sort; }
-  Sort get_sort_shadow() const { return d_sort_shadow; }
+  /** Get the sort of the i-th backend solver. */
+  Sort get_sort(size_t i) const { return d_backend_sorts[i]; }
 
  private:
-  Sort d_sort;
-  Sort d_sort_shadow;
+  /**
+   * Query all backend sorts via 'fun' and check that they agree.
+   * Returns the result of the solver under test.
+   */
+  template <typename T>
+  T get_checked(const std::function<T(const Sort&)>& fun) const
+  {
+    T res = fun(d_backend_sorts[0]);
+    for (size_t i = 1, n = d_backend_sorts.size(); i < n; ++i)
+    {
+      if (d_backend_sorts[i])
+      {
+        MURXLA_TEST(res == fun(d_backend_sorts[i]));
+      }
+    }
+    return res;
+  }
+  /** Create a ShadowSort from the sorts returned by 'fun' for each backend. */
+  Sort get_mapped(const std::function<Sort(const Sort&)>& fun) const;
+
+  std::vector<Sort> d_backend_sorts;
 };
 
+/**
+ * The term of a ShadowSolver, wraps one term per backend solver.
+ *
+ * The term of a backend that was disabled before the term was created is
+ * nullptr.
+ */
 class ShadowTerm : public AbsTerm
 {
   friend class ShadowSolver;
 
  public:
-  ShadowTerm(Term term, Term term_shadow);
+  ShadowTerm(const std::vector<Term>& terms);
   ~ShadowTerm() override;
   size_t hash() const override;
   bool equals(const Term& other) const override;
@@ -112,33 +149,64 @@ class ShadowTerm : public AbsTerm
   void set_special_value_kind(const SpecialValueKind& value_kind) override;
   void set_leaf_kind(LeafKind kind) override;
 
-  Term get_term() const { return d_term; }
-  Term get_term_shadow() const { return d_term_shadow; }
+  /** Get the term of the i-th backend solver. */
+  Term get_term(size_t i) const { return d_backend_terms[i]; }
 
  private:
-  Term d_term;
-  Term d_term_shadow;
+  std::vector<Term> d_backend_terms;
 };
 
+/**
+ * Differential testing of a solver against one or more shadow solvers.
+ *
+ * All API calls are executed in lockstep on all backend solvers, the first
+ * backend is the solver under test.  With a single shadow solver
+ * (--cross-check), the satisfiability results of both solvers must agree.
+ * With more shadow solvers (--vote), results are compared via majority vote,
+ * and a disagreement is reported as an error that lists the solvers in the
+ * minority.
+ *
+ * When voting, a shadow solver that does not support a call (raises a
+ * MurxlaConfigException) or an option is disabled for the rest of the run,
+ * the remaining backends continue.
+ */
 class ShadowSolver : public Solver
 {
  public:
-  static void get_sorts_helper(const std::vector<Sort>& sorts,
-                               std::vector<Sort>& sorts_orig,
-                               std::vector<Sort>& sorts_shadow);
-
-  static void get_param_sort_helper(Sort sort,
-                                    Sort& sort_orig,
-                                    Sort& sort_shadow);
-  static void get_unresolved_sort_helper(Sort sort,
-                                         Sort& sort_orig,
-                                         Sort& sort_shadow);
-
-  static void get_terms_helper(const std::vector<Term>& terms,
-                               std::vector<Term>& terms_orig,
-                               std::vector<Term>& terms_shadow);
-
-  ShadowSolver(SolverSeedGenerator& sng, Solver* solver, Solver* solver_shadow);
+  /**
+   * Get the sort of the i-th backend solver for given sort.
+   * Parametric and unresolved sorts are copied with their associated sorts
+   * resolved to the sorts of the i-th backend.
+   */
+  static Sort get_sort_helper(Sort sort, size_t i);
+  /** Get the sorts of the i-th backend solver for given sorts. */
+  static std::vector<Sort> get_sorts_helper(const std::vector<Sort>& sorts,
+                                            size_t i);
+  /** Get the terms of the i-th backend solver for given terms. */
+  static std::vector<Term> get_terms_helper(const std::vector<Term>& terms,
+                                            size_t i);
+  /** Get the datatype constructors for the i-th backend solver. */
+  static AbsSort::DatatypeConstructorMap get_dt_ctors_helper(
+      const AbsSort::DatatypeConstructorMap& ctors, size_t i);
+
+  /**
+   * Constructor.
+   * sng       : The associated solver seed generator.
+   * solvers   : The backend solvers, the first is the solver under test,
+   *             all others are shadow solvers (at least one).
+   * concurrent: True to execute expensive calls (check_sat(),
+   *             check_sat_assuming(), get_unsat_assumptions(),
+   *             get_unsat_core(), get_value()) on all backends concurrently.
+   *             Requires that backend instances do not share (global) state.
+   * perf_ratio: The maximum ratio of the time of a satisfiability check of
+   *             the solver under test to the time of the fastest other
+   *             backend, checks that exceed this ratio are reported as
+   *             performance anomaly.  0 if disabled.
+   */
+  ShadowSolver(SolverSeedGenerator& sng,
+               const std::vector<Solver*>& solvers,
+               bool concurrent   = false,
+               double perf_ratio = 0);
   ~ShadowSolver() override;
 
   void new_solver() override;
@@ -229,13 +297,91 @@ class ShadowSolver : public Solver
   void disable_unsupported_actions(FSM* fsm) const override;
 
  protected:
-  /** The solver under test. */
-  std::unique_ptr<Solver> d_solver;
-  /** The solver used for checking. */
-  std::unique_ptr<Solver> d_solver_shadow;
-  /** Flag that indicates whether d_solver and d_solver_shadow are instances of
-   * the same solver. */
-  bool d_same_solver;
+  /**
+   * Call 'fun' for each enabled backend solver, 'fun' gets the index of the
+   * backend as argument.  If 'concurrent' is true and concurrent execution is
+   * enabled, all backends other than the solver under test are called in
+   * separate threads.
+   *
+   * When voting, shadow solvers that raise a MurxlaConfigException are
+   * disabled, all other exceptions are passed on.
+   *
+   * The time of each call is recorded in d_times.
+   * Returns the results of all backends, the result of a disabled backend
+   * is default constructed.
+   */
+  template <typename T>
+  std::vector<T> call_solvers(const std::function<T(size_t)>& fun,
+                              bool concurrent = false)
+  {
+    size_t n = d_solvers.size();
+    std::vector<T> res(n);
+    std::function<T(size_t)> fun_timed = [&](size_t i) {
+      double start = get_cur_wall_time();
+      T r          = fun(i);
+      d_times[i]   = get_cur_wall_time() - start;
+      return r;
+    };
+    /* Note: The destructors of futures returned by std::async block until
+     *       the call is done, even if the solver under test throws. */
+    std::vector<std::future<T>> futures(n);
+    for (size_t i = 1; concurrent && d_concurrent && i < n; ++i)
+    {
+      if (d_enabled[i])
+      {
+        futures[i] = std::async(std::launch::async, fun_timed, i);
+      }
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (!d_enabled[i]) continue;
+      try
+      {
+        res[i] = futures[i].valid() ? futures[i].get() : fun_timed(i);
+      }
+      catch (MurxlaConfigException& e)
+      {
+        if (i == 0 || !d_voting) throw;
+        d_enabled[i] = false;
+      }
+    }
+    return res;
+  }
+
+  /** Call 'fun' for each enabled backend (see call_solvers()). */
+  void for_each_solver(const std::function<void(size_t)>& fun);
+
+  /**
+   * Compare given satisfiability results of all enabled backends (by means
+   * of a majority vote if d_voting is true).  Unknown results are ignored.
+   * Returns the result of the solver under test.
+   */
+  Result vote(const std::vector<Result>& results) const;
+
+  /**
+   * Check the times of the last call_solvers() call against the performance
+   * anomaly ratio (see --perf-ratio).
+   * action: The kind of the action that performed the call.
+   */
+  void check_perf(const std::string& action) const;
+
+  /** The backend solvers, the first is the solver under test. */
+  std::vector<std::unique_ptr<Solver>> d_solvers;
+  /** True for backends that are not disabled. */
+  std::vector<bool> d_enabled;
+  /**
+   * True if the results of more than two backends are compared by majority
+   * vote.
+   */
+  bool d_voting;
+  /** True if all backends are instances of the same solver. */
+  bool d_same_solver = true;
+  /** True if expensive calls are executed concurrently on all backends. */
+  bool d_concurrent;
+  /** The performance anomaly ratio, 0 if disabled. */
+  double d_perf_ratio;
+  /** The times of the last call_solvers() call, per backend. */
+  std::vector<double> d_times;
 };
 
 }  // namespace shadow
@@ -0,0 +1,1005 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "solver/mock/mock_solver.hpp"
+
+#include <cassert>
+#include <sstream>
+
+#include "except.hpp"
+#include "solver/mock/profile.hpp"
+#include "util.hpp"
+
+namespace murxla {
+namespace mock {
+
+/* -------------------------------------------------------------------------- */
+/* MockSort                                                                   */
+/* -------------------------------------------------------------------------- */
+
+size_t
+MockSort::hash() const
+{
+  return std::hash<uint64_t>{}(d_mock_id);
+}
+
+bool
+MockSort::equals(const Sort& other) const
+{
+  return d_mock_id == checked_cast<MockSort*>(other.get())->get_mock_id();
+}
+
+std::string
+MockSort::to_string() const
+{
+  std::stringstream ss;
+  switch (d_sort_kind)
+  {
+    case SORT_ARRAY: ss << "(Array"; break;
+    case SORT_BAG: ss << "(Bag"; break;
+    case SORT_BOOL: ss << "Bool"; break;
+    case SORT_BV: ss << "(_ BitVec " << d_bv_size << ")"; break;
+    case SORT_FF: ss << "(_ FiniteField " << d_name << ")"; break;
+    case SORT_FP:
+      ss << "(_ FloatingPoint " << d_bv_size << " " << d_sig_size << ")";
+      break;
+    case SORT_FUN: ss << "(->"; break;
+    case SORT_INT: ss << "Int"; break;
+    case SORT_REAL: ss << "Real"; break;
+    case SORT_REGLAN: ss << "RegLan"; break;
+    case SORT_RM: ss << "RoundingMode"; break;
+    case SORT_SEQ: ss << "(Seq"; break;
+    case SORT_SET: ss << "(Set"; break;
+    case SORT_STRING: ss << "String"; break;
+    default:
+      assert(d_sort_kind == SORT_DT || d_sort_kind == SORT_UNINTERPRETED);
+      if (!d_element_sorts.empty()) ss << "(";
+      ss << d_name;
+  }
+  if (!d_element_sorts.empty())
+  {
+    for (const auto& s : d_element_sorts)
+    {
+      ss << " " << s->to_string();
+    }
+    ss << ")";
+  }
+  return ss.str();
+}
+
+bool
+MockSort::is_array() const
+{
+  return d_sort_kind == SORT_ARRAY;
+}
+
+bool
+MockSort::is_bag() const
+{
+  return d_sort_kind == SORT_BAG;
+}
+
+bool
+MockSort::is_bool() const
+{
+  return d_sort_kind == SORT_BOOL;
+}
+
+bool
+MockSort::is_bv() const
+{
+  return d_sort_kind == SORT_BV;
+}
+
+bool
+MockSort::is_dt() const
+{
+  return d_sort_kind == SORT_DT;
+}
+
+bool
+MockSort::is_dt_parametric() const
+{
+  return is_dt() && !get_sorts().empty();
+}
+
+bool
+MockSort::is_ff() const
+{
+  return d_sort_kind == SORT_FF;
+}
+
+bool
+MockSort::is_fp() const
+{
+  return d_sort_kind == SORT_FP;
+}
+
+bool
+MockSort::is_fun() const
+{
+  return d_sort_kind == SORT_FUN;
+}
+
+bool
+MockSort::is_int() const
+{
+  return d_sort_kind == SORT_INT;
+}
+
+bool
+MockSort::is_real() const
+{
+  return d_sort_kind == SORT_REAL;
+}
+
+bool
+MockSort::is_rm() const
+{
+  return d_sort_kind == SORT_RM;
+}
+
+bool
+MockSort::is_seq() const
+{
+  return d_sort_kind == SORT_SEQ;
+}
+
+bool
+MockSort::is_set() const
+{
+  return d_sort_kind == SORT_SET;
+}
+
+bool
+MockSort::is_string() const
+{
+  return d_sort_kind == SORT_STRING;
+}
+
+bool
+MockSort::is_uninterpreted() const
+{
+  return d_sort_kind == SORT_UNINTERPRETED;
+}
+
+bool
+MockSort::is_reglan() const
+{
+  return d_sort_kind == SORT_REGLAN;
+}
+
+uint32_t
+MockSort::get_bv_size() const
+{
+  assert(is_bv());
+  return d_bv_size;
+}
+
+std::string
+MockSort::get_dt_name() const
+{
+  assert(is_dt());
+  return d_name;
+}
+
+std::string
+MockSort::get_ff_size() const
+{
+  assert(is_ff());
+  return d_name;
+}
+
+uint32_t
+MockSort::get_fp_exp_size() const
+{
+  assert(is_fp());
+  return d_bv_size;
+}
+
+uint32_t
+MockSort::get_fp_sig_size() const
+{
+  assert(is_fp());
+  return d_sig_size;
+}
+
+Sort
+MockSort::get_array_index_sort() const
+{
+  assert(is_array());
+  assert(d_element_sorts.size() == 2);
+  return d_element_sorts[0];
+}
+
+Sort
+MockSort::get_array_element_sort() const
+{
+  assert(is_array());
+  assert(d_element_sorts.size() == 2);
+  return d_element_sorts[1];
+}
+
+uint32_t
+MockSort::get_fun_arity() const
+{
+  assert(is_fun());
+  assert(d_element_sorts.size() > 1);
+  return static_cast<uint32_t>(d_element_sorts.size() - 1);
+}
+
+Sort
+MockSort::get_fun_codomain_sort() const
+{
+  assert(is_fun());
+  return d_element_sorts.back();
+}
+
+std::vector<Sort>
+MockSort::get_fun_domain_sorts() const
+{
+  assert(is_fun());
+  return {d_element_sorts.begin(), d_element_sorts.end() - 1};
+}
+
+Sort
+MockSort::get_bag_element_sort() const
+{
+  assert(is_bag());
+  assert(d_element_sorts.size() == 1);
+  return d_element_sorts[0];
+}
+
+Sort
+MockSort::get_seq_element_sort() const
+{
+  assert(is_seq());
+  assert(d_element_sorts.size() == 1);
+  return d_element_sorts[0];
+}
+
+Sort
+MockSort::get_set_element_sort() const
+{
+  assert(is_set());
+  assert(d_element_sorts.size() == 1);
+  return d_element_sorts[0];
+}
+
+uint64_t
+MockSort::get_mock_id() const
+{
+  return d_mock_id;
+}
+
+/* -------------------------------------------------------------------------- */
+/* MockTerm                                                                   */
+/* -------------------------------------------------------------------------- */
+
+size_t
+MockTerm::hash() const
+{
+  return std::hash<uint64_t>{}(d_mock_id);
+}
+
+bool
+MockTerm::equals(const Term& other) const
+{
+  return d_mock_id == checked_cast<MockTerm*>(other.get())->get_mock_id();
+}
+
+std::string
+MockTerm::to_string() const
+{
+  if (d_args.empty() && d_kind == Op::UNDEFINED)
+  {
+    return d_symbol;
+  }
+  /* Non-leaf arguments are referred to by id, printing them recursively would
+   * blow up exponentially on shared subterms. */
+  std::stringstream ss;
+  ss << "(" << d_kind;
+  for (const auto& s : d_str_args)
+  {
+    ss << " " << s;
+  }
+  for (const auto& i : d_indices)
+  {
+    ss << " " << i;
+  }
+  for (const auto& a : d_args)
+  {
+    const MockTerm* arg = checked_cast<MockTerm*>(a.get());
+    if (arg->d_kind == Op::UNDEFINED)
+    {
+      ss << " " << arg->d_symbol;
+    }
+    else
+    {
+      ss << " @" << arg->d_mock_id;
+    }
+  }
+  ss << ")";
+  return ss.str();
+}
+
+const Op::Kind&
+MockTerm::get_kind() const
+{
+  return d_kind;
+}
+
+std::vector<Term>
+MockTerm::get_children() const
+{
+  return d_args;
+}
+
+const std::vector<Term>&
+MockTerm::get_args() const
+{
+  return d_args;
+}
+
+const std::vector<std::string>&
+MockTerm::get_str_args() const
+{
+  return d_str_args;
+}
+
+const std::vector<uint32_t>&
+MockTerm::get_indices_uint32() const
+{
+  return d_indices;
+}
+
+uint64_t
+MockTerm::get_mock_id() const
+{
+  return d_mock_id;
+}
+
+/* -------------------------------------------------------------------------- */
+/* MockSolver                                                                 */
+/* -------------------------------------------------------------------------- */
+
+bool
+MockSolver::TermKey::operator==(const TermKey& other) const
+{
+  return d_sort == other.d_sort && d_args == other.d_args
+         && d_indices == other.d_indices && d_kind == other.d_kind
+         && d_str_args == other.d_str_args;
+}
+
+size_t
+MockSolver::TermKeyHash::operator()(const TermKey& key) const
+{
+  size_t h = std::hash<std::string>{}(key.d_kind);
+  hash_combine(h, key.d_sort);
+  for (const auto& arg : key.d_args)
+  {
+    hash_combine(h, arg);
+  }
+  for (const auto& arg : key.d_str_args)
+  {
+    hash_combine(h, arg);
+  }
+  for (const auto& idx : key.d_indices)
+  {
+    hash_combine(h, idx);
+  }
+  return h;
+}
+
+MockSolver::MockSolver(SolverSeedGenerator& sng) : Solver(sng) {}
+
+MockSolver::~MockSolver() { delete_solver(); }
+
+void
+MockSolver::new_solver()
+{
+  d_initialized = true;
+}
+
+void
+MockSolver::delete_solver()
+{
+  d_terms.clear();
+  d_sort_ids.clear();
+  d_initialized = false;
+}
+
+bool
+MockSolver::is_initialized() const
+{
+  return d_initialized;
+}
+
+const std::string
+MockSolver::get_name() const
+{
+  return "Mock";
+}
+
+const std::string
+MockSolver::get_profile() const
+{
+  return s_profile;
+}
+
+Sort
+MockSolver::mk_mock_sort(SortKind kind,
+                         const std::vector<Sort>& sorts,
+                         uint32_t bv_size,
+                         uint32_t sig_size,
+                         const std::string& name)
+{
+  std::vector<uint64_t> ids;
+  for (const auto& s : sorts)
+  {
+    ids.push_back(checked_cast<MockSort*>(s.get())->get_mock_id());
+  }
+  auto [it, inserted] = d_sort_ids.emplace(
+      SortKey(kind, bv_size, sig_size, name, std::move(ids)), d_n_sorts + 1);
+  if (inserted) d_n_sorts += 1;
+  return std::make_shared<MockSort>(
+      it->second, kind, sorts, bv_size, sig_size, name);
+}
+
+Term
+MockSolver::mk_mock_term(const Op::Kind& kind,
+                         const std::vector<std::string>& str_args,
+                         const std::vector<Term>& args,
+                         const std::vector<uint32_t>& indices,
+                         Sort sort,
+                         const std::string& symbol)
+{
+  TermKey key{kind, str_args, {}, indices, 0};
+  key.d_args.reserve(args.size());
+  for (const auto& a : args)
+  {
+    key.d_args.push_back(checked_cast<MockTerm*>(a.get())->get_mock_id());
+  }
+  if (sort)
+  {
+    key.d_sort = checked_cast<MockSort*>(sort.get())->get_mock_id();
+  }
+
+  auto it = d_terms.find(key);
+  if (it != d_terms.end())
+  {
+    return it->second;
+  }
+  Term res = std::make_shared<MockTerm>(
+      ++d_n_terms, kind, str_args, args, indices, symbol);
+  if (sort) res->set_sort(sort);
+  d_terms.emplace(std::move(key), res);
+  return res;
+}
+
+Term
+MockSolver::mk_fresh_term(const Op::Kind& kind,
+                          const std::vector<Term>& args,
+                          const std::string& symbol)
+{
+  d_n_terms += 1;
+  return std::make_shared<MockTerm>(
+      d_n_terms,
+      kind,
+      std::vector<std::string>{},
+      args,
+      std::vector<uint32_t>{},
+      symbol.empty() ? "_m" + std::to_string(d_n_terms) : symbol);
+}
+
+Term
+MockSolver::mk_mock_value(Sort sort, const std::string& value)
+{
+  return mk_mock_term(Op::UNDEFINED, {value}, {}, {}, sort, value);
+}
+
+Term
+MockSolver::mk_var(Sort sort, const std::string& name)
+{
+  return mk_fresh_term(Op::UNDEFINED, {}, name);
+}
+
+Term
+MockSolver::mk_const(Sort sort, const std::string& name)
+{
+  return mk_fresh_term(Op::UNDEFINED, {}, name);
+}
+
+Term
+MockSolver::mk_fun(const std::string& name,
+                   const std::vector<Term>& args,
+                   Term body)
+{
+  std::vector<Term> fun_args(args.begin(), args.end());
+  fun_args.push_back(body);
+  return mk_fresh_term(Op::FUN, fun_args, name);
+}
+
+Term
+MockSolver::mk_value(Sort sort, bool value)
+{
+  assert(sort->is_bool());
+  return mk_mock_value(sort, value ? "true" : "false");
+}
+
+Term
+MockSolver::mk_value(Sort sort, const std::string& value)
+{
+  assert(sort->is_ff() || sort->is_fp() || sort->is_int() || sort->is_real()
+         || sort->is_string());
+  return mk_mock_value(sort, value);
+}
+
+Term
+MockSolver::mk_value(Sort sort, const std::string& num, const std::string& den)
+{
+  assert(sort->is_real());
+  return mk_mock_value(sort, num + "/" + den);
+}
+
+Term
+MockSolver::mk_value(Sort sort, const std::string& value, Base base)
+{
+  assert(sort->is_bv());
+  switch (base)
+  {
+    case DEC: return mk_mock_value(sort, value);
+    case HEX: return mk_mock_value(sort, "#x" + value);
+    default: assert(base == BIN); return mk_mock_value(sort, "#b" + value);
+  }
+}
+
+Term
+MockSolver::mk_special_value(Sort sort, const AbsTerm::SpecialValueKind& value)
+{
+  return mk_mock_value(sort, value);
+}
+
+Sort
+MockSolver::mk_sort(const std::string& name)
+{
+  return mk_mock_sort(SORT_UNINTERPRETED, {}, 0, 0, name);
+}
+
+Sort
+MockSolver::mk_sort(SortKind kind)
+{
+  assert(kind == SORT_BOOL || kind == SORT_INT || kind == SORT_REAL
+         || kind == SORT_RM || kind == SORT_STRING || kind == SORT_REGLAN);
+  return mk_mock_sort(kind);
+}
+
+Sort
+MockSolver::mk_sort(SortKind kind, const std::string& size)
+{
+  assert(kind == SORT_FF);
+  return mk_mock_sort(kind, {}, 0, 0, size);
+}
+
+Sort
+MockSolver::mk_sort(SortKind kind, uint32_t size)
+{
+  assert(kind == SORT_BV);
+  return mk_mock_sort(kind, {}, size);
+}
+
+Sort
+MockSolver::mk_sort(SortKind kind, uint32_t esize, uint32_t ssize)
+{
+  assert(kind == SORT_FP);
+  return mk_mock_sort(kind, {}, esize, ssize);
+}
+
+Sort
+MockSolver::mk_sort(SortKind kind, const std::vector<Sort>& sorts)
+{
+  assert(kind == SORT_ARRAY || kind == SORT_BAG || kind == SORT_FUN
+         || kind == SORT_SEQ || kind == SORT_SET);
+  return mk_mock_sort(kind, sorts);
+}
+
+std::vector<Sort>
+MockSolver::mk_sort(
+    SortKind kind,
+    const std::vector<std::string>& dt_names,
+    const std::vector<std::vector<Sort>>& param_sorts,
+    const std::vector<AbsSort::DatatypeConstructorMap>& constructors)
+{
+  assert(kind == SORT_DT);
+  assert(dt_names.size() == param_sorts.size());
+  assert(dt_names.size() == constructors.size());
+
+  /* Constructors and selectors are recorded on the Murxla level, the mock
+   * solver only needs to identify datatype sorts by name. */
+  std::vector<Sort> res;
+  for (const auto& name : dt_names)
+  {
+    res.push_back(mk_mock_sort(SORT_DT, {}, 0, 0, name));
+  }
+  return res;
+}
+
+Sort
+MockSolver::instantiate_sort(Sort param_sort, const std::vector<Sort>& sorts)
+{
+  return mk_mock_sort(SORT_DT, sorts, 0, 0, param_sort->get_dt_name());
+}
+
+Term
+MockSolver::mk_term(const Op::Kind& kind,
+                    const std::vector<Term>& args,
+                    const std::vector<uint32_t>& indices)
+{
+  return mk_mock_term(kind, {}, args, indices, nullptr, "");
+}
+
+Term
+MockSolver::mk_term(const Op::Kind& kind,
+                    const std::vector<std::string>& str_args,
+                    const std::vector<Term>& args)
+{
+  return mk_mock_term(kind, str_args, args, {}, nullptr, "");
+}
+
+Term
+MockSolver::mk_term(const Op::Kind& kind,
+                    Sort sort,
+                    const std::vector<std::string>& str_args,
+                    const std::vector<Term>& args)
+{
+  return mk_mock_term(kind,
+                      str_args,
+                      args,
+                      {},
+                      kind == Op::DT_APPLY_CONS ? sort : nullptr,
+                      "");
+}
+
+Sort
+MockSolver::get_sort(Term term, SortKind sort_kind)
+{
+  /* Already computed sort for `term`.*/
+  if (term->get_sort() != nullptr)
+  {
+    return term->get_sort();
+  }
+
+  assert(sort_kind != SORT_ANY);
+
+  /* Compute sort for `term`. */
+  MockTerm* mock_term                 = checked_cast<MockTerm*>(term.get());
+  const std::vector<Term>& args       = mock_term->get_args();
+  const std::vector<uint32_t>& params = mock_term->get_indices_uint32();
+  const Op::Kind& kind                = mock_term->get_kind();
+
+  if (kind == Op::ITE)
+  {
+    assert(args.size() == 3);
+    return args[2]->get_sort();
+  }
+
+  if (kind == Op::ARRAY_SELECT)
+  {
+    assert(args.size() == 2);
+    return args[0]->get_sort()->get_array_element_sort();
+  }
+
+  if (kind == Op::UF_APPLY)
+  {
+    return args[0]->get_sort()->get_fun_codomain_sort();
+  }
+
+  if (kind == Op::SEQ_NTH)
+  {
+    assert(args.size() == 2);
+    return args[0]->get_sort()->get_seq_element_sort();
+  }
+
+  if (kind == Op::BAG_CHOOSE)
+  {
+    assert(args.size() == 1);
+    return args[0]->get_sort()->get_bag_element_sort();
+  }
+
+  if (kind == Op::SET_CHOOSE)
+  {
+    assert(args.size() == 1);
+    return args[0]->get_sort()->get_set_element_sort();
+  }
+
+  if (kind == Op::DT_APPLY_SEL)
+  {
+    assert(args.size() == 1);
+    Sort dt_sort = args[0]->get_sort();
+    return dt_sort->get_dt_sel_sort(dt_sort,
+                                    mock_term->get_str_args()[0],
+                                    mock_term->get_str_args()[1]);
+  }
+
+  if (kind == Op::DT_MATCH || kind == Op::DT_MATCH_BIND_CASE
+      || kind == Op::DT_MATCH_CASE)
+  {
+    assert(args.size() >= 1);
+    return args.back()->get_sort();
+  }
+
+  switch (sort_kind)
+  {
+    case SORT_BOOL:
+    case SORT_INT:
+    case SORT_REAL:
+    case SORT_RM:
+    case SORT_STRING:
+    case SORT_REGLAN: return mk_mock_sort(sort_kind);
+
+    case SORT_BV:
+      if (kind == Op::BV_CONCAT)
+      {
+        uint32_t bv_size = 0;
+        for (const Term& a : args)
+        {
+          bv_size += a->get_sort()->get_bv_size();
+        }
+        return mk_mock_sort(SORT_BV, {}, bv_size);
+      }
+      if (kind == Op::BV_EXTRACT)
+      {
+        assert(params.size() == 2);
+        assert(params[0] >= params[1]);
+        return mk_mock_sort(SORT_BV, {}, params[0] - params[1] + 1);
+      }
+      if (kind == Op::BV_ZERO_EXTEND || kind == Op::BV_SIGN_EXTEND)
+      {
+        return mk_mock_sort(
+            SORT_BV, {}, args[0]->get_sort()->get_bv_size() + params[0]);
+      }
+      if (kind == Op::BV_REPEAT)
+      {
+        return mk_mock_sort(
+            SORT_BV, {}, args[0]->get_sort()->get_bv_size() * params[0]);
+      }
+      if (kind == Op::BV_COMP)
+      {
+        return mk_mock_sort(SORT_BV, {}, 1);
+      }
+      if (kind == Op::FP_TO_SBV || kind == Op::FP_TO_UBV)
+      {
+        assert(params.size() == 1);
+        return mk_mock_sort(SORT_BV, {}, params[0]);
+      }
+      break;
+
+    case SORT_FP:
+      if (kind == Op::FP_TO_FP_FROM_BV || kind == Op::FP_TO_FP_FROM_SBV
+          || kind == Op::FP_TO_FP_FROM_FP || kind == Op::FP_TO_FP_FROM_UBV
+          || kind == Op::FP_TO_FP_FROM_REAL)
+      {
+        assert(params.size() == 2);
+        return mk_mock_sort(SORT_FP, {}, params[0], params[1]);
+      }
+      if (kind == Op::FP_FP)
+      {
+        assert(args.size() == 3);
+        return mk_mock_sort(SORT_FP,
+                            {},
+                            args[1]->get_sort()->get_bv_size(),
+                            args[0]->get_sort()->get_bv_size()
+                                + args[2]->get_sort()->get_bv_size());
+      }
+      /* FP operators with FP operands, the rounding mode comes first. */
+      return args.back()->get_sort();
+
+    case SORT_SEQ:
+      if (kind == Op::SEQ_UNIT)
+      {
+        return mk_mock_sort(SORT_SEQ, {args[0]->get_sort()});
+      }
+      break;
+
+    case SORT_BAG:
+      if (kind == Op::BAG_MAKE)
+      {
+        return mk_mock_sort(SORT_BAG, {args[0]->get_sort()});
+      }
+      if (kind == Op::BAG_FROM_SET)
+      {
+        return mk_mock_sort(SORT_BAG,
+                            {args[0]->get_sort()->get_set_element_sort()});
+      }
+      if (kind == Op::BAG_MAP)
+      {
+        /* given as { bag, function } */
+        return mk_mock_sort(SORT_BAG,
+                            {args[1]->get_sort()->get_fun_codomain_sort()});
+      }
+      break;
+
+    case SORT_SET:
+      if (kind == Op::SET_SINGLETON)
+      {
+        return mk_mock_sort(SORT_SET, {args[0]->get_sort()});
+      }
+      if (kind == Op::BAG_TO_SET)
+      {
+        return mk_mock_sort(SORT_SET,
+                            {args[0]->get_sort()->get_bag_element_sort()});
+      }
+      if (kind == Op::SET_COMPREHENSION)
+      {
+        /* given as { predicate, term, var_1, ..., var_n } */
+        return mk_mock_sort(SORT_SET, {args[1]->get_sort()});
+      }
+      break;
+
+    case SORT_FUN:
+    {
+      std::vector<Sort> sorts;
+      for (const auto& arg : args)
+      {
+        sorts.push_back(arg->get_sort());
+      }
+      return mk_mock_sort(SORT_FUN, sorts);
+    }
+
+    default: break;
+  }
+
+  /* All remaining operators have the sort of their first argument, e.g.,
+   * OP_BV_ADD, OP_FINITE_FIELD_ADD, OP_SEQ_CONCAT, OP_SET_INSERT. */
+  MURXLA_EXIT_ERROR_CONFIG(args.empty())
+      << "operator " << kind << " not configured for mock solver";
+  return args[0]->get_sort();
+}
+
+void
+MockSolver::assert_formula(const Term& t)
+{
+}
+
+Solver::Result
+MockSolver::check_sat()
+{
+  return pick_result();
+}
+
+Solver::Result
+MockSolver::check_sat_assuming(const std::vector<Term>& assumptions)
+{
+  return pick_result();
+}
+
+std::vector<Term>
+MockSolver::get_unsat_assumptions()
+{
+  return std::vector<Term>();
+}
+
+std::vector<Term>
+MockSolver::get_unsat_core()
+{
+  return std::vector<Term>();
+}
+
+void
+MockSolver::push(uint32_t n_levels)
+{
+}
+
+void
+MockSolver::pop(uint32_t n_levels)
+{
+}
+
+void
+MockSolver::print_model()
+{
+}
+
+void
+MockSolver::reset()
+{
+  /* Terms are undefined after a reset, Murxla resets its term database. */
+  d_terms.clear();
+}
+
+void
+MockSolver::reset_assertions()
+{
+}
+
+void
+MockSolver::set_opt(const std::string& opt, const std::string& value)
+{
+  if (opt == get_option_name_model_gen())
+  {
+    d_model_gen = value == "true";
+  }
+  if (opt == get_option_name_unsat_assumptions())
+  {
+    d_unsat_assumptions = value == "true";
+  }
+  if (opt == get_option_name_unsat_cores())
+  {
+    d_unsat_cores = value == "true";
+  }
+}
+
+std::string
+MockSolver::get_option_name_incremental() const
+{
+  return "incremental";
+}
+
+std::string
+MockSolver::get_option_name_model_gen() const
+{
+  return "produce-models";
+}
+
+std::string
+MockSolver::get_option_name_unsat_assumptions() const
+{
+  return "produce-unsat-assumptions";
+}
+
+std::string
+MockSolver::get_option_name_unsat_cores() const
+{
+  return "produce-unsat-cores";
+}
+
+bool
+MockSolver::option_incremental_enabled() const
+{
+  return true;
+}
+
+bool
+MockSolver::option_model_gen_enabled() const
+{
+  return d_model_gen;
+}
+
+bool
+MockSolver::option_unsat_assumptions_enabled() const
+{
+  return d_unsat_assumptions;
+}
+
+bool
+MockSolver::option_unsat_cores_enabled() const
+{
+  return d_unsat_cores;
+}
+
+bool
+MockSolver::is_unsat_assumption(const Term& t) const
+{
+  return true;
+}
+
+std::vector<Term>
+MockSolver::get_value(const std::vector<Term>& terms)
+{
+  return terms;
+}
+
+Solver::Result
+MockSolver::pick_result()
+{
+  return d_rng.flip_coin() ? Result::SAT : Result::UNSAT;
+}
+
+}  // namespace mock
+}  // namespace murxla
@@ -0,0 +1,362 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__MOCK_SOLVER_H
+#define __MURXLA__MOCK_SOLVER_H
+
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+#include "solver/solver.hpp"
+
+/* -------------------------------------------------------------------------- */
+
+namespace murxla {
+namespace mock {
+
+/* -------------------------------------------------------------------------- */
+/* MockSort                                                                   */
+/* -------------------------------------------------------------------------- */
+
+class MockSort : public AbsSort
+{
+ public:
+  /**
+   * Constructor.
+   * mock_id : The id of this sort, unique for structurally equal sorts of
+   *           the solver that created it (see MockSolver::mk_mock_sort()).
+   * kind    : The kind of this sort.
+   * sorts   : The element sorts of array, bag, function, sequence and set
+   *           sorts, the sorts an instantiated datatype sort is instantiated
+   *           with.
+   * bv_size : The bit-vector size, doubles as exponent size for FP sorts.
+   * sig_size: The floating-point significand size.
+   * name    : The name of datatype and uninterpreted sorts, the size of
+   *           finite field sorts.
+   */
+  MockSort(uint64_t mock_id,
+           SortKind kind,
+           const std::vector<Sort>& sorts,
+           uint32_t bv_size,
+           uint32_t sig_size,
+           const std::string& name)
+      : d_mock_id(mock_id),
+        d_sort_kind(kind),
+        d_element_sorts(sorts),
+        d_bv_size(bv_size),
+        d_sig_size(sig_size),
+        d_name(name)
+  {
+  }
+  ~MockSort(){};
+  size_t hash() const override;
+  bool equals(const Sort& other) const override;
+  std::string to_string() const override;
+  bool is_array() const override;
+  bool is_bag() const override;
+  bool is_bool() const override;
+  bool is_bv() const override;
+  bool is_dt() const override;
+  bool is_dt_parametric() const override;
+  bool is_ff() const override;
+  bool is_fp() const override;
+  bool is_fun() const override;
+  bool is_int() const override;
+  bool is_real() const override;
+  bool is_rm() const override;
+  bool is_seq() const override;
+  bool is_set() const override;
+  bool is_string() const override;
+  bool is_uninterpreted() const override;
+  bool is_reglan() const override;
+  uint32_t get_bv_size() const override;
+  std::string get_dt_name() const override;
+  std::string get_ff_size() const override;
+  uint32_t get_fp_exp_size() const override;
+  uint32_t get_fp_sig_size() const override;
+  Sort get_array_index_sort() const override;
+  Sort get_array_element_sort() const override;
+  uint32_t get_fun_arity() const override;
+  Sort get_fun_codomain_sort() const override;
+  std::vector<Sort> get_fun_domain_sorts() const override;
+  Sort get_bag_element_sort() const override;
+  Sort get_seq_element_sort() const override;
+  Sort get_set_element_sort() const override;
+
+  uint64_t get_mock_id() const;
+
+ private:
+  /** The id of this sort, equal for structurally equal sorts. */
+  uint64_t d_mock_id;
+  /** The kind of this sort, as created by the solver. */
+  SortKind d_sort_kind;
+  /** The element sorts of this sort. */
+  std::vector<Sort> d_element_sorts;
+  /**
+   * The bit-vector size of this sort.
+   * Doubles as exponent size for FP sorts.
+   */
+  uint32_t d_bv_size;
+  /** The floating-point significand size of this sort. */
+  uint32_t d_sig_size;
+  /** The name of this sort, or the size of this finite field sort. */
+  std::string d_name;
+};
+
+/* -------------------------------------------------------------------------- */
+/* MockTerm                                                                   */
+/* -------------------------------------------------------------------------- */
+
+class MockTerm : public AbsTerm
+{
+ public:
+  /**
+   * Constructor.
+   * mock_id : The id of this term, unique for structurally equal terms of the
+   *           solver that created it (terms are hash-consed).
+   * kind    : The operator kind of this term, Op::UNDEFINED for leafs.
+   * str_args: The string arguments of this term, only for DT operator kinds.
+   * args    : The arguments (children) of this term.
+   * indices : The indices of this term.
+   * symbol  : The symbol of this term, only for leafs.
+   */
+  MockTerm(uint64_t mock_id,
+           const Op::Kind& kind,
+           const std::vector<std::string>& str_args,
+           const std::vector<Term>& args,
+           const std::vector<uint32_t>& indices,
+           const std::string& symbol)
+      : d_mock_id(mock_id),
+        d_kind(kind),
+        d_str_args(str_args),
+        d_args(args),
+        d_indices(indices),
+        d_symbol(symbol)
+  {
+  }
+  ~MockTerm(){};
+  size_t hash() const override;
+  bool equals(const Term& other) const override;
+  std::string to_string() const override;
+
+  const Op::Kind& get_kind() const override;
+  std::vector<Term> get_children() const override;
+  const std::vector<Term>& get_args() const;
+  const std::vector<std::string>& get_str_args() const;
+  const std::vector<uint32_t>& get_indices_uint32() const;
+
+  uint64_t get_mock_id() const;
+
+ private:
+  /** The id of this term, equal for structurally equal terms. */
+  uint64_t d_mock_id;
+  /** The operator kind of this term. */
+  Op::Kind d_kind;
+  /** The string arguments of this term. Only needed for DT operator kinds. */
+  std::vector<std::string> d_str_args;
+  /** The arguments (children) of this term. */
+  std::vector<Term> d_args;
+  /** The indices of this term. */
+  std::vector<uint32_t> d_indices;
+  /** The symbol of this term, the value for value terms. Only for leafs. */
+  std::string d_symbol;
+};
+
+/* -------------------------------------------------------------------------- */
+/* MockSolver                                                                 */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A deterministic mock solver for measuring the overhead of Murxla itself.
+ *
+ * Sorts and terms are cheap and hash-consed, no output is produced and no
+ * external solver is involved.  Satisfiability checks randomly answer sat or
+ * unsat, based on the solver RNG, which is seeded deterministically for each
+ * action.  Hence, runs are reproducible and can be traced and untraced as with
+ * any other solver.
+ */
+class MockSolver : public Solver
+{
+ public:
+  MockSolver(SolverSeedGenerator& sng);
+  ~MockSolver() override;
+
+  void new_solver() override;
+  void delete_solver() override;
+  bool is_initialized() const override;
+  const std::string get_name() const override;
+  const std::string get_profile() const override;
+
+  Term mk_var(Sort sort, const std::string& name) override;
+  Term mk_const(Sort sort, const std::string& name) override;
+  Term mk_fun(const std::string& name,
+              const std::vector<Term>& args,
+              Term body) override;
+
+  Term mk_value(Sort sort, bool value) override;
+  Term mk_value(Sort sort, const std::string& value) override;
+  Term mk_value(Sort sort,
+                const std::string& num,
+                const std::string& den) override;
+  Term mk_value(Sort sort, const std::string& value, Base base) override;
+  Term mk_special_value(Sort sort,
+                        const AbsTerm::SpecialValueKind& value) override;
+
+  Sort mk_sort(const std::string& name) override;
+  Sort mk_sort(SortKind kind) override;
+  Sort mk_sort(SortKind kind, const std::string& size) override;
+  Sort mk_sort(SortKind kind, uint32_t size) override;
+  Sort mk_sort(SortKind kind, uint32_t esize, uint32_t ssize) override;
+  Sort mk_sort(SortKind kind, const std::vector<Sort>& sorts) override;
+  std::vector<Sort> mk_sort(
+      SortKind kind,
+      const std::vector<std::string>& dt_names,
+      const std::vector<std::vector<Sort>>& param_sorts,
+      const std::vector<AbsSort::DatatypeConstructorMap>& constructors)
+      override;
+  Sort instantiate_sort(Sort param_sort,
+                        const std::vector<Sort>& sorts) override;
+
+  Term mk_term(const Op::Kind& kind,
+               const std::vector<Term>& args,
+               const std::vector<uint32_t>& indices) override;
+  Term mk_term(const Op::Kind& kind,
+               const std::vector<std::string>& str_args,
+               const std::vector<Term>& args) override;
+  Term mk_term(const Op::Kind& kind,
+               Sort sort,
+               const std::vector<std::string>& str_args,
+               const std::vector<Term>& args) override;
+
+  Sort get_sort(Term term, SortKind sort_kind) override;
+
+  std::string get_option_name_incremental() const override;
+  std::string get_option_name_model_gen() const override;
+  std::string get_option_name_unsat_assumptions() const override;
+  std::string get_option_name_unsat_cores() const override;
+  bool option_incremental_enabled() const override;
+  bool option_model_gen_enabled() const override;
+  bool option_unsat_assumptions_enabled() const override;
+  bool option_unsat_cores_enabled() const override;
+
+  bool is_unsat_assumption(const Term& t) const override;
+
+  void assert_formula(const Term& t) override;
+
+  Result check_sat() override;
+  Result check_sat_assuming(const std::vector<Term>& assumptions) override;
+
+  std::vector<Term> get_unsat_assumptions() override;
+
+  std::vector<Term> get_unsat_core() override;
+
+  void push(uint32_t n_levels) override;
+  void pop(uint32_t n_levels) override;
+
+  void print_model() override;
+
+  void reset() override;
+  void reset_assertions() override;
+
+  void set_opt(const std::string& opt, const std::string& value) override;
+
+  std::vector<Term> get_value(const std::vector<Term>& terms) override;
+
+ private:
+  /**
+   * The structural key of a sort: its kind, bit-vector (exponent) size,
+   * significand size, name (or finite field size) and the ids of its element
+   * sorts.
+   */
+  using SortKey = std::tuple<SortKind,
+                             uint32_t,
+                             uint32_t,
+                             std::string,
+                             std::vector<uint64_t>>;
+
+  /**
+   * The structural key of a term: its kind, string arguments, the ids of its
+   * arguments, its indices and the id of its sort, if the sort is given on
+   * construction (values and datatype constructor applications).
+   */
+  struct TermKey
+  {
+    Op::Kind d_kind;
+    std::vector<std::string> d_str_args;
+    std::vector<uint64_t> d_args;
+    std::vector<uint32_t> d_indices;
+    uint64_t d_sort = 0;
+
+    bool operator==(const TermKey& other) const;
+  };
+
+  /** Hash function for term keys. */
+  struct TermKeyHash
+  {
+    size_t operator()(const TermKey& key) const;
+  };
+
+  /**
+   * Create a sort. Structurally equal sorts get the same id, thus sorts are
+   * compared in constant time.
+   */
+  Sort mk_mock_sort(SortKind kind,
+                    const std::vector<Sort>& sorts = {},
+                    uint32_t bv_size                = 0,
+                    uint32_t sig_size               = 0,
+                    const std::string& name         = "");
+
+  /**
+   * Create a term. Structurally equal terms are hash-consed, i.e., the term
+   * that was created first is returned.
+   * sort  : The sort of the term if given on construction, else nullptr.
+   * symbol: The symbol of a leaf term.
+   */
+  Term mk_mock_term(const Op::Kind& kind,
+                    const std::vector<std::string>& str_args,
+                    const std::vector<Term>& args,
+                    const std::vector<uint32_t>& indices,
+                    Sort sort,
+                    const std::string& symbol);
+
+  /** Create a fresh, i.e., not hash-consed, leaf term. */
+  Term mk_fresh_term(const Op::Kind& kind,
+                     const std::vector<Term>& args,
+                     const std::string& symbol);
+
+  /** Create a value term of given sort. */
+  Term mk_mock_value(Sort sort, const std::string& value);
+
+  /** Pick a random satisfiability result. */
+  Result pick_result();
+
+  /** True if the solver is initialized. */
+  bool d_initialized = false;
+  /** True if model generation is enabled. */
+  bool d_model_gen = false;
+  /** True if unsat assumptions are enabled. */
+  bool d_unsat_assumptions = false;
+  /** True if unsat cores are enabled. */
+  bool d_unsat_cores = false;
+
+  /** The number of created sort ids. */
+  uint64_t d_n_sorts = 0;
+  /** The number of created term ids. */
+  uint64_t d_n_terms = 0;
+  /** Map structural sort keys to sort ids. */
+  std::map<SortKey, uint64_t> d_sort_ids;
+  /** The hash-consed terms, cleared on reset. */
+  std::unordered_map<TermKey, Term, TermKeyHash> d_terms;
+};
+
+}  // namespace mock
+}  // namespace murxla
+
+#endif
@@ -9,14 +9,19 @@
  */
 #include "smt2_solver.hpp"
 
+#include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <chrono>
 #include <unordered_map>
 
+#include "config.hpp"
 #include "exit.hpp"
 #include "murxla.hpp"
 #include "solver/smt2/profile.hpp"
@@ -523,13 +528,23 @@ get_default(const std::unordered_map<std::string, std::string>& map,
 }
 }  // namespace
 
-const std::string
-Smt2Term::get_repr() const
+const std::string*
+Smt2Term::get_name(uint64_t epoch) const
+{
+  return epoch > 0 && d_name_epoch == epoch ? &d_name : nullptr;
+}
+
+const std::string&
+Smt2Term::get_repr(uint64_t epoch) const
 {
   if (!d_repr.empty())
   {
     return d_repr;
   }
+  if (!d_repr_cache.empty() && d_repr_epoch == epoch)
+  {
+    return d_repr_cache;
+  }
 
   std::vector<const Smt2Term*> visit;
   std::unordered_map<const Smt2Term*, std::string> cache;
@@ -550,8 +565,9 @@ Smt2Term::get_repr() const
     if (it == cache.end())
     {
       cache.emplace(cur, "");
-      /* Do not go below quantifiers. */
-      if (new_scope.find(cur->d_kind) != new_scope.end())
+      /* Do not go below quantifiers and named terms. */
+      if (new_scope.find(cur->d_kind) != new_scope.end()
+          || (cur != this && cur->get_name(epoch)))
       {
         continue;
       }
@@ -573,6 +589,13 @@ Smt2Term::get_repr() const
     const auto& it = cache.find(cur);
     if (it == cache.end())
     {
+      const std::string* name = cur != this ? cur->get_name(epoch) : nullptr;
+      if (name)
+      {
+        cache.emplace(cur, *name);
+        visit.pop_back();
+        continue;
+      }
       cache.emplace(cur, "");
       for (const auto& arg : cur->d_args)
       {
@@ -580,6 +603,12 @@ Smt2Term::get_repr() const
       }
       continue;
     }
+    else if (!it->second.empty())
+    {
+      /* Already printed. */
+      visit.pop_back();
+      continue;
+    }
     else
     {
       std::stringstream res;
@@ -596,22 +625,22 @@ Smt2Term::get_repr() const
         if (cur->d_kind == Op::DT_APPLY_TESTER)
         {
           assert(cur->d_str_args.size() == 1);
-          res << "((_ " << d_op_kind_to_str.at(cur->d_kind) << " "
+          res << "((_ " << op_kind_to_str().at(cur->d_kind) << " "
               << cur->d_str_args[0] << ")";
         }
         else if (cur->d_kind == Op::DT_APPLY_UPDATER)
         {
           assert(cur->d_str_args.size() == 2);
-          res << "((_ " << d_op_kind_to_str.at(cur->d_kind) << " "
+          res << "((_ " << op_kind_to_str().at(cur->d_kind) << " "
               << cur->d_str_args[1] << ")";
         }
         else if (cur->d_kind == Op::DT_MATCH)
         {
-          res << "(" << d_op_kind_to_str.at(cur->d_kind) << " "
-              << to_smt2_term(cur->d_args[i++])->get_repr() << " (";
+          res << "(" << op_kind_to_str().at(cur->d_kind) << " "
+              << to_smt2_term(cur->d_args[i++])->get_repr(epoch) << " (";
           for (size_t n = cur->d_args.size(); i < n; ++i)
           {
-            res << to_smt2_term(cur->d_args[i])->get_repr();
+            res << to_smt2_term(cur->d_args[i])->get_repr(epoch);
           }
           res << "))";
         }
@@ -621,8 +650,8 @@ Smt2Term::get_repr() const
           {
             /* variable pattern */
             assert(cur->d_args.size() == 2);
-            res << "(" << to_smt2_term(cur->d_args[0])->get_repr() << " "
-                << to_smt2_term(cur->d_args[1])->get_repr() << ")";
+            res << "(" << to_smt2_term(cur->d_args[0])->get_repr(epoch) << " "
+                << to_smt2_term(cur->d_args[1])->get_repr(epoch) << ")";
             i = 2;
           }
           else
@@ -631,10 +660,10 @@ Smt2Term::get_repr() const
             for (size_t n = cur->d_args.size() - 1; i < n; ++i)
             {
               if (i > 0) res << " ";
-              res << to_smt2_term(cur->d_args[i])->get_repr();
+              res << to_smt2_term(cur->d_args[i])->get_repr(epoch);
             }
             res << ") ";
-            res << to_smt2_term(cur->d_args[i++])->get_repr();
+            res << to_smt2_term(cur->d_args[i++])->get_repr(epoch);
             res << ")";
           }
         }
@@ -643,7 +672,7 @@ Smt2Term::get_repr() const
           assert(cur->d_str_args.size() == 1);
           assert(cur->d_args.size() == 1);
           res << "(" << cur->d_str_args[0] << " "
-              << to_smt2_term(cur->d_args[0])->get_repr() << ") ";
+              << to_smt2_term(cur->d_args[0])->get_repr(epoch) << ") ";
           i = cur->d_args.size();
         }
         else if (cur->d_indices.empty())
@@ -654,7 +683,7 @@ Smt2Term::get_repr() const
           }
           if (cur->d_kind == Op::UF_APPLY)
           {
-            res << to_smt2_term(cur->d_args[0])->get_repr();
+            res << to_smt2_term(cur->d_args[0])->get_repr(epoch);
             i += 1;
           }
           else if (cur->d_kind == Op::DT_APPLY_CONS)
@@ -669,7 +698,7 @@ Smt2Term::get_repr() const
           }
           else
           {
-            res << get_default(d_op_kind_to_str, cur->d_kind, cur->d_kind);
+            res << get_default(op_kind_to_str(), cur->d_kind, cur->d_kind);
           }
           if (cur->d_kind == Op::FORALL || cur->d_kind == Op::EXISTS
               || cur->d_kind == Op::SET_COMPREHENSION)
@@ -703,7 +732,7 @@ Smt2Term::get_repr() const
         else
         {
           res << "((_ "
-              << get_default(d_op_kind_to_str, cur->d_kind, cur->d_kind);
+              << get_default(op_kind_to_str(), cur->d_kind, cur->d_kind);
           for (uint32_t p : cur->d_indices)
           {
             res << " " << p;
@@ -769,38 +798,56 @@ Smt2Term::get_repr() const
     res << itt->second;
   }
 
-  return res.str();
+  d_repr_cache = res.str();
+  d_repr_epoch = epoch;
+  return d_repr_cache;
 }
 
 /* -------------------------------------------------------------------------- */
 /* Smt2Solver                                                                 */
 /* -------------------------------------------------------------------------- */
 
-/* Trim whitespaces (in place) from given str. */
-static void
-trim_str(std::string& s)
+/* Trim whitespaces from given str. */
+static std::string_view
+trim_str(std::string_view s)
 {
-  /* trim from left */
-  s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](int ch) {
-            return !std::isspace(ch);
-          }));
-  /* trim from right */
-  s.erase(std::find_if(
-              s.rbegin(), s.rend(), [](int ch) { return !std::isspace(ch); })
-              .base(),
-          s.end());
+  size_t begin = 0, end = s.size();
+  while (begin < end && std::isspace(static_cast<unsigned char>(s[begin])))
+  {
+    ++begin;
+  }
+  while (end > begin && std::isspace(static_cast<unsigned char>(s[end - 1])))
+  {
+    --end;
+  }
+  return s.substr(begin, end - begin);
 }
 
 void
 Smt2Solver::push_to_external(std::string s, ResponseKind expected)
 {
   assert(d_file_to);
-  assert(d_file_from);
+  assert(d_fd_from >= 0);
   fputs(s.c_str(), d_file_to);
   fputc('\n', d_file_to);
+  if (d_pipeline && expected == ResponseKind::SMT2_SUCCESS)
+  {
+    check_external_errors();
+    return;
+  }
   fflush(d_file_to);
-  std::string res = get_from_external();
-  trim_str(res);
+  std::string_view res = trim_str(get_from_external());
+  if (d_pipeline)
+  {
+    /* Skip 'success' responses in case print-success is still enabled (e.g.,
+     * for pooled solvers) and report errors of previously streamed commands.
+     */
+    while (res == "success")
+    {
+      res = trim_str(get_from_external());
+    }
+    check_external_response(res);
+  }
   switch (expected)
   {
     case ResponseKind::SMT2_SUCCESS:
@@ -835,7 +882,8 @@ Smt2Solver::push_to_external(std::string s, ResponseKind expected)
       break;
     default:
       assert(expected == ResponseKind::SMT2_SEXPR);
-      if (res[0] != '(' || res.find("error") != std::string::npos
+      if (res.empty() || res[0] != '('
+          || res.find("error") != std::string::npos
           || res.find("Error") != std::string::npos
           || res.find("ERROR") != std::string::npos)
       {
@@ -851,50 +899,181 @@ Smt2Solver::push_to_external(std::string s, ResponseKind expected)
  * Either parses one line or an s-expression if the first character of the
  * stream is '('.
  */
-std::string
-Smt2Solver::get_from_external() const
+std::string_view
+Smt2Solver::get_from_external(bool echo)
 {
-  std::vector<std::string> lines;
-  std::stringstream ss;
-  size_t in_sexpr = 0;
-  size_t nchars   = 0;
+  /* Discard the previous response, keep data that was read ahead. */
+  d_read_buf.erase(0, d_read_pos);
+  d_read_pos = 0;
+
+  size_t pos = 0, in_sexpr = 0;
+  bool in_string = false, in_symbol = false;
   while (true)
   {
-    int32_t c = fgetc(d_file_from);
-    ++nchars;
-    if (c == EOF)
+    /* Scan the data read so far, continue where the last scan stopped. */
+    for (; pos < d_read_buf.size(); ++pos)
     {
-      return "[EOF]";
+      char c = d_read_buf[pos];
+      if (in_string)
+      {
+        in_string = c != '"';
+      }
+      else if (in_symbol)
+      {
+        in_symbol = c != '|';
+      }
+      else if (c == '"')
+      {
+        in_string = true;
+      }
+      else if (c == '|' && in_sexpr)
+      {
+        in_symbol = true;
+      }
+      else if (c == '(' && (in_sexpr || pos == 0))
+      {
+        ++in_sexpr;
+      }
+      else if (c == ')' && in_sexpr)
+      {
+        --in_sexpr;
+      }
+      else if (c == '\n' && !in_sexpr)
+      {
+        d_read_pos = pos + 1;
+        std::string_view res(d_read_buf.data(), d_read_pos);
+        if (echo && d_trace_responses)
+        {
+          for (size_t i = 0, j; i < res.size(); i = j + 1)
+          {
+            j = res.find('\n', i);
+            d_out << "; " << res.substr(i, j - i + 1);
+          }
+          d_out << std::flush;
+        }
+        return res;
+      }
     }
-    else if (c == '(' && (in_sexpr || nchars == 1))
+
+    size_t size = d_read_buf.size();
+    d_read_buf.resize(size + SMT2_READ_SIZE);
+    ssize_t n = read(d_fd_from, &d_read_buf[size], SMT2_READ_SIZE);
+    d_read_buf.resize(size + static_cast<size_t>(std::max<ssize_t>(n, 0)));
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return "[EOF]";
+  }
+}
+
+void
+Smt2Solver::check_external_errors()
+{
+  struct pollfd fd = {d_fd_from, POLLIN, 0};
+  while (d_read_pos < d_read_buf.size() || poll(&fd, 1, 0) > 0)
+  {
+    check_external_response(trim_str(get_from_external()));
+  }
+}
+
+void
+Smt2Solver::check_external_response(std::string_view res) const
+{
+  if (res == "[EOF]")
+  {
+    std::cerr << "[murxla] SMT2: Error: online solver terminated unexpectedly"
+              << std::endl;
+    exit(EXIT_ERROR);
+  }
+  if (res.substr(0, 6) == "(error")
+  {
+    std::cerr << "[murxla] SMT2: Error: online solver reported error '" << res
+              << "'" << std::endl;
+    exit(EXIT_ERROR);
+  }
+}
+
+void
+Smt2Solver::sync_external()
+{
+  /* Not dumped to d_out, this is only for synchronizing with the solver. */
+  static const std::string marker = "murxla-sync";
+  fputs(("(echo \"" + marker + "\")\n").c_str(), d_file_to);
+  fflush(d_file_to);
+  while (true)
+  {
+    std::string_view res = trim_str(get_from_external(false));
+    check_external_response(res);
+    if (res.find(marker) != std::string::npos) break;
+  }
+}
+
+const std::string&
+Smt2Solver::get_smt2_repr(const Term& term)
+{
+  Smt2Term* smt2_term = to_smt2_term(term);
+  define_shared_terms(smt2_term);
+  const std::string* name = smt2_term->get_name(d_epoch);
+  return name ? *name : smt2_term->get_repr(d_epoch);
+}
+
+void
+Smt2Solver::define_shared_terms(Smt2Term* term)
+{
+  std::vector<std::pair<Smt2Term*, bool>> visit{{term, false}};
+  std::unordered_map<Smt2Term*, uint64_t> refs;
+  std::vector<Smt2Term*> post_order;
+
+  /* Count references, do not go below leafs and named terms. */
+  while (!visit.empty())
+  {
+    auto [cur, expanded] = visit.back();
+    visit.pop_back();
+    if (expanded)
     {
-      ++in_sexpr;
+      post_order.push_back(cur);
+      continue;
     }
-    else if (c == ')' && in_sexpr)
+    if (refs[cur]++ > 0) continue;
+    if (!cur->d_repr.empty() || cur->get_name(d_epoch)) continue;
+    visit.emplace_back(cur, true);
+    for (const auto& arg : cur->d_args)
     {
-      --in_sexpr;
+      visit.emplace_back(to_smt2_term(arg), false);
     }
+  }
 
-    ss << ((char) c);
-    if (c == '\n')
+  for (Smt2Term* cur : post_order)
+  {
+    cur->d_has_vars = false;
+    for (const auto& arg : cur->d_args)
     {
-      lines.push_back(ss.str());
-      ss.str("");
-      ss.clear();
+      Smt2Term* a = to_smt2_term(arg);
+      if (a->get_leaf_kind() == AbsTerm::LeafKind::VARIABLE
+          || (a->d_repr.empty() && a->d_has_vars))
+      {
+        cur->d_has_vars = true;
+        break;
+      }
     }
-    if (c == '\n' && !in_sexpr)
+
+    bool shared = refs.at(cur) > 1 || cur->d_printed_epoch == d_epoch;
+    cur->d_printed_epoch = d_epoch;
+    if (!shared || cur->d_has_vars || cur->d_args.empty()
+        || cur->get_sort() == nullptr
+        || cur->d_kind == Op::DT_MATCH_CASE
+        || cur->d_kind == Op::DT_MATCH_BIND_CASE)
     {
-      break;
+      continue;
     }
+
+    std::stringstream name, smt2;
+    name << "_t" << d_n_named_terms++;
+    smt2 << "(define-fun " << name.str() << " () "
+         << static_cast<Smt2Sort*>(cur->get_sort().get())->get_repr() << " "
+         << cur->get_repr(d_epoch) << ")";
+    dump_smt2(smt2.str());
+    cur->d_name       = name.str();
+    cur->d_name_epoch = d_epoch;
   }
-  std::string res;
-  for (auto& line : lines)
-  {
-    d_out << "; " << line;
-    res += line;
-  }
-  d_out << std::flush;
-  return res;
 }
 
 void
@@ -904,15 +1083,223 @@ Smt2Solver::dump_smt2(std::string s, ResponseKind expected)
   if (d_online) push_to_external(s, expected);
 }
 
+/* -------------------------------------------------------------------------- */
+/* Smt2OnlineSolverPool                                                       */
+/* -------------------------------------------------------------------------- */
+
+Smt2OnlineSolverPool::Process
+Smt2OnlineSolverPool::spawn(const std::string& solver_call)
+{
+  Process res;
+  int32_t fd_to[2], fd_from[2];
+
+  /* Open input/output pipes from and to the external online solver. */
+  MURXLA_EXIT_ERROR(pipe(fd_to) != 0) << "creating input pipe failed";
+  MURXLA_EXIT_ERROR(pipe(fd_from) != 0) << "creating output pipe failed";
+
+  res.d_pid = fork();
+
+  MURXLA_EXIT_ERROR_FORK(res.d_pid < 0, true)
+      << "forking solver process failed.";
+
+  /* Online solver process. */
+  if (res.d_pid == 0)
+  {
+    close(fd_to[SMT2_WRITE_END]);
+    dup2(fd_to[SMT2_READ_END], STDIN_FILENO);
+
+    close(fd_from[SMT2_READ_END]);
+    /* Redirect stdout of external solver to write end. */
+    dup2(fd_from[SMT2_WRITE_END], STDOUT_FILENO);
+    /* Redirect stderr of external solver to write end. */
+    dup2(fd_from[SMT2_WRITE_END], STDERR_FILENO);
+
+    std::vector<char*> execv_args;
+    std::string arg;
+    std::stringstream ss(solver_call);
+    while (std::getline(ss, arg, ' '))
+    {
+      execv_args.push_back(strdup(arg.c_str()));
+    }
+    execv_args.push_back(nullptr);
+
+    execv(execv_args[0], execv_args.data());
+
+    for (char* s : execv_args)
+    {
+      free(s);
+    }
+
+    MURXLA_EXIT_ERROR_FORK(true, true)
+        << "'" << solver_call << "' is not executable";
+  }
+
+  close(fd_to[SMT2_READ_END]);
+  close(fd_from[SMT2_WRITE_END]);
+  /* Do not leak the pipes into other (pooled) online solver processes, they
+   * would otherwise never see EOF on stdin. */
+  fcntl(fd_to[SMT2_WRITE_END], F_SETFD, FD_CLOEXEC);
+  fcntl(fd_from[SMT2_READ_END], F_SETFD, FD_CLOEXEC);
+  res.d_fd_to   = fd_to[SMT2_WRITE_END];
+  res.d_fd_from = fd_from[SMT2_READ_END];
+  return res;
+}
+
+Smt2OnlineSolverPool::Smt2OnlineSolverPool(const std::string& solver_call)
+    : d_solver_call(solver_call)
+{
+}
+
+Smt2OnlineSolverPool::~Smt2OnlineSolverPool()
+{
+  kill_process(d_checked_out);
+  for (Process& p : d_idle)
+  {
+    kill_process(p);
+  }
+}
+
+void
+Smt2OnlineSolverPool::checkout()
+{
+  assert(d_checked_out.d_pid == 0);
+  while (!d_idle.empty())
+  {
+    Process p = d_idle.back();
+    d_idle.pop_back();
+    /* Skip solver processes that terminated while idle. */
+    if (waitpid(p.d_pid, nullptr, WNOHANG) == 0)
+    {
+      d_checked_out = p;
+      return;
+    }
+    p.d_pid = 0;
+    kill_process(p);
+  }
+  d_checked_out = spawn(d_solver_call);
+}
+
+Smt2OnlineSolverPool::Process
+Smt2OnlineSolverPool::take()
+{
+  Process res   = d_checked_out;
+  d_checked_out = Process();
+  return res;
+}
+
+void
+Smt2OnlineSolverPool::checkin(bool reuse)
+{
+  if (d_checked_out.d_pid == 0) return;
+  if (reuse && reset(d_checked_out))
+  {
+    d_idle.push_back(d_checked_out);
+  }
+  else
+  {
+    kill_process(d_checked_out);
+  }
+  d_checked_out = Process();
+}
+
+bool
+Smt2OnlineSolverPool::reaped(pid_t pid)
+{
+  if (d_checked_out.d_pid == pid)
+  {
+    d_checked_out.d_pid = 0;
+    return true;
+  }
+  for (auto it = d_idle.begin(); it != d_idle.end(); ++it)
+  {
+    if (it->d_pid == pid)
+    {
+      it->d_pid = 0;
+      kill_process(*it);
+      d_idle.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+Smt2OnlineSolverPool::reset(const Process& process)
+{
+  /* The solver prints 'success' for (reset) and (set-option) and then echoes
+   * the marker, which tells us that all pending output has been consumed. */
+  static const std::string marker = "murxla-pool-sync";
+  std::string cmd = "(reset)\n(set-option :print-success true)\n(echo \""
+                    + marker + "\")\n";
+
+  /* Do not get killed if the solver terminated in the meantime. */
+  auto sigpipe = signal(SIGPIPE, SIG_IGN);
+  bool written = write(process.d_fd_to, cmd.data(), cmd.size())
+                 == static_cast<ssize_t>(cmd.size());
+  signal(SIGPIPE, sigpipe);
+  if (!written) return false;
+
+  auto start = std::chrono::steady_clock::now();
+  std::string response;
+  struct pollfd fd = {process.d_fd_from, POLLIN, 0};
+  while (true)
+  {
+    double remaining =
+        MURXLA_SMT2_RESET_TIME
+        - std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                        - start)
+              .count();
+    if (remaining <= 0) return false;
+    int32_t n = poll(&fd, 1, static_cast<int32_t>(remaining * 1000) + 1);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+
+    char buf[1024];
+    ssize_t size = read(process.d_fd_from, buf, sizeof(buf));
+    if (size < 0 && errno == EINTR) continue;
+    if (size <= 0) return false;
+    response.append(buf, static_cast<size_t>(size));
+
+    size_t pos = response.find(marker);
+    if (pos != std::string::npos
+        && response.find('\n', pos) != std::string::npos)
+    {
+      return true;
+    }
+  }
+}
+
+void
+Smt2OnlineSolverPool::kill_process(Process& process)
+{
+  if (process.d_pid > 0)
+  {
+    kill(process.d_pid, SIGKILL);
+    waitpid(process.d_pid, nullptr, 0);
+  }
+  if (process.d_fd_to >= 0) close(process.d_fd_to);
+  if (process.d_fd_from >= 0) close(process.d_fd_from);
+  process = Process();
+}
+
+/* -------------------------------------------------------------------------- */
+/* Smt2Solver                                                                 */
+/* -------------------------------------------------------------------------- */
+
 Smt2Solver::Smt2Solver(SolverSeedGenerator& sng,
                        std::ostream& out,
-                       const std::string& solver_binary)
+                       const std::string& solver_binary,
+                       bool pipeline,
+                       bool trace_responses,
+                       Smt2OnlineSolverPool* pool)
     : Solver(sng),
       d_out(out),
       d_online(!solver_binary.empty()),
+      d_pipeline(pipeline && d_online),
       d_file_to(nullptr),
-      d_file_from(nullptr),
-      d_solver_call(solver_binary)
+      d_trace_responses(trace_responses),
+      d_solver_call(solver_binary),
+      d_pool(pool)
 {
 }
 
@@ -930,70 +1317,42 @@ Smt2Solver::new_solver()
 {
   if (d_online)
   {
-    int32_t fd_to[2], fd_from[2];
-
-    /* Open input/output pipes from and to the external online solver. */
-    MURXLA_EXIT_ERROR(pipe(fd_to) != 0) << "creating input pipe failed";
-    MURXLA_EXIT_ERROR(pipe(fd_from) != 0) << "creating output pipe failed";
-
-    d_online_pid = fork();
+    Smt2OnlineSolverPool::Process process;
 
-    MURXLA_EXIT_ERROR_FORK(d_online_pid < 0, true)
-        << "forking solver process failed.";
-
-    /* Online solver process. */
-    if (d_online_pid == 0)
+    if (d_pool)
     {
-      close(fd_to[SMT2_WRITE_END]);
-      dup2(fd_to[SMT2_READ_END], STDIN_FILENO);
-
-      close(fd_from[SMT2_READ_END]);
-      /* Redirect stdout of external solver to write end. */
-      dup2(fd_from[SMT2_WRITE_END], STDOUT_FILENO);
-      /* Redirect stderr of external solver to write end. */
-      dup2(fd_from[SMT2_WRITE_END], STDERR_FILENO);
-
-      std::vector<char*> execv_args;
-      std::string arg;
-      std::stringstream ss(d_solver_call);
-      while (std::getline(ss, arg, ' '))
-      {
-        execv_args.push_back(strdup(arg.c_str()));
-      }
-      execv_args.push_back(nullptr);
-
-      execv(execv_args[0], execv_args.data());
-
-      for (char* s : execv_args)
-      {
-        free(s);
-      }
-
-      MURXLA_EXIT_ERROR_FORK(true, true)
-          << "'" << d_solver_call << "' is not executable";
+      process  = d_pool->take();
+      d_pooled = process.d_pid > 0;
+    }
+    if (!d_pooled)
+    {
+      process      = Smt2OnlineSolverPool::spawn(d_solver_call);
+      d_online_pid = process.d_pid;
     }
 
     /* Kill online solver in case the SMT2 solver process gets a SIGINT signal.
      * This ensures that the online solver process will always be cleaned up in
      * case it runs into a timeout. */
-    s_online_solver_pid = d_online_pid;
+    s_online_solver_pid = process.d_pid;
     signal(SIGINT, kill_online_solver);
 
-    close(fd_to[SMT2_READ_END]);
-    close(fd_from[SMT2_WRITE_END]);
-    d_file_to   = fdopen(fd_to[SMT2_WRITE_END], "w");
-    d_file_from = fdopen(fd_from[SMT2_READ_END], "r");
+    d_file_to = fdopen(process.d_fd_to, "w");
+    d_fd_from = process.d_fd_from;
 
     MURXLA_EXIT_ERROR_FORK(d_file_to == nullptr, true)
         << "opening read channel to external solver failed";
-    MURXLA_EXIT_ERROR_FORK(d_file_from == nullptr, true)
-        << "opening write channel to external solver failed";
+
+    if (d_pipeline)
+    {
+      setvbuf(d_file_to, nullptr, _IOFBF, 1 << 20);
+    }
   }
 
   d_initialized = true;
   if (d_online)
   {
-    dump_smt2("(set-option :print-success true)");
+    dump_smt2(d_pipeline ? "(set-option :print-success false)"
+                         : "(set-option :print-success true)");
   }
   /* Global declarations must always enabled since via the API there's no such
    * concept of scoped declaration of symbols. */
@@ -1003,7 +1362,16 @@ Smt2Solver::new_solver()
 void
 Smt2Solver::delete_solver()
 {
+  /* Make sure that errors of streamed commands are reported. */
+  if (d_pipeline) sync_external();
+  if (d_pooled)
+  {
+    /* Pooled solver processes are reset and reused by the parent process. */
+    d_out << "(exit)" << std::endl << std::flush;
+    return;
+  }
   dump_smt2("(exit)");
+  if (d_pipeline) fflush(d_file_to);
 }
 
 bool
@@ -1093,10 +1461,9 @@ Smt2Solver::mk_fun(const std::string& name,
   }
   smt2 << ") ";
 
-  const auto& t = to_smt2_term(body);
   const auto& s = checked_cast<Smt2Sort*>(body->get_sort().get());
 
-  smt2 << s->get_repr() << " " << t->get_repr() << ")";
+  smt2 << s->get_repr() << " " << get_smt2_repr(body) << ")";
 
   dump_smt2(smt2.str());
   std::vector<Term> smt2_args(args.begin(), args.end());
@@ -1978,8 +2345,7 @@ void
 Smt2Solver::assert_formula(const Term& t)
 {
   std::stringstream smt2;
-  Smt2Term* smt2_term = static_cast<Smt2Term*>(t.get());
-  smt2 << "(assert " << smt2_term->get_repr() << ")";
+  smt2 << "(assert " << get_smt2_repr(t) << ")";
   dump_smt2(smt2.str());
 }
 
@@ -1997,9 +2363,8 @@ Smt2Solver::check_sat_assuming(const std::vector<Term>& assumptions)
   smt2 << "(check-sat-assuming ( ";
   for (size_t i = 0, n = assumptions.size(); i < n; ++i)
   {
-    Smt2Term* smt2_term = static_cast<Smt2Term*>(assumptions[i].get());
     if (i > 0) smt2 << " ";
-    smt2 << smt2_term->get_repr();
+    smt2 << get_smt2_repr(assumptions[i]);
   }
   smt2 << "))";
   dump_smt2(smt2.str(), ResponseKind::SMT2_SAT);
@@ -2054,6 +2419,8 @@ void
 Smt2Solver::reset()
 {
   dump_smt2("(reset)");
+  /* All named terms are undefined after a reset. */
+  d_epoch += 1;
 }
 
 void
@@ -2147,9 +2514,8 @@ Smt2Solver::get_value(const std::vector<Term>& terms)
   smt2 << "(get-value (";
   for (size_t i = 0, n = terms.size(); i < n; ++i)
   {
-    Smt2Term* smt2_term = static_cast<Smt2Term*>(terms[i].get());
     if (i > 0) smt2 << " ";
-    smt2 << smt2_term->get_repr();
+    smt2 << get_smt2_repr(terms[i]);
   }
   smt2 << "))";
   dump_smt2(smt2.str(), ResponseKind::SMT2_SEXPR);
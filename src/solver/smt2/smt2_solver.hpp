@@ -10,6 +10,8 @@
 #ifndef __MURXLA__SMT2_SOLVER_H
 #define __MURXLA__SMT2_SOLVER_H
 
+#include <string_view>
+
 #include "fsm.hpp"
 #ifdef MURXLA_USE_CVC5
 #include "solver/cvc5/cvc5_solver.hpp"
@@ -97,6 +99,8 @@ class Smt2Sort : public AbsSort
 
 class Smt2Term : public AbsTerm
 {
+  friend class Smt2Solver;
+
  public:
   Smt2Term(Op::Kind kind,
            std::vector<std::string> str_args,
@@ -120,7 +124,16 @@ class Smt2Term : public AbsTerm
   const std::vector<Term>& get_args() const;
   const std::vector<std::string>& get_str_args() const;
   const std::vector<uint32_t>& get_indices_uint32() const;
-  const std::string get_repr() const;
+  /**
+   * Get the SMT-LIB representation of this term.
+   *
+   * Shared subterms are bound via let binders, subterms that have been named
+   * via define-fun in the given epoch (see Smt2Solver::get_smt2_repr()) are
+   * referred to by name.  The result is cached on the term for that epoch.
+   *
+   * epoch: The current naming epoch of the solver, 0 if no subterms are named.
+   */
+  const std::string& get_repr(uint64_t epoch = 0) const;
 
  private:
   /** The operator kind of this term. */
@@ -134,253 +147,367 @@ class Smt2Term : public AbsTerm
   /** The smt2 representation of this term. */
   std::string d_repr;
 
-  std::unordered_map<std::string, std::string> d_op_kind_to_str = {
-      {Op::DISTINCT, "distinct"},
-      {Op::EQUAL, "="},
-      {Op::ITE, "ite"},
-
-      /* Boolean */
-      {Op::AND, "and"},
-      {Op::IFF, "="},
-      {Op::IMPLIES, "=>"},
-      {Op::NOT, "not"},
-      {Op::OR, "or"},
-      {Op::XOR, "xor"},
-
-      /* Arrays */
-      {Op::ARRAY_SELECT, "select"},
-      {Op::ARRAY_STORE, "store"},
-
-      /* Bags */
-      {Op::BAG_UNION_MAX, "bag.union_max"},
-      {Op::BAG_UNION_DISJOINT, "bag.union_disjoint"},
-      {Op::BAG_INTERSECTION_MIN, "bag.inter_min"},
-      {Op::BAG_DIFFERENCE_SUBTRACT, "bag.difference_subtract"},
-      {Op::BAG_DIFFERENCE_REMOVE, "bag.difference_remove"},
-      {Op::BAG_SUBBAG, "bag.subbag"},
-      {Op::BAG_COUNT, "bag.count"},
-      {Op::BAG_DUPLICATE_REMOVAL, "bag.duplicate_removal"},
-      {Op::BAG_MAKE, "bag"},
-      {Op::BAG_EMPTY, "bag.empty"},
-      {Op::BAG_CARD, "bag.card"},
-      {Op::BAG_CHOOSE, "bag.choose"},
-      {Op::BAG_IS_SINGLETON, "bag.is_singleton"},
-      {Op::BAG_FROM_SET, "bag.from_set"},
-      {Op::BAG_TO_SET, "bag.to_set"},
-      {Op::BAG_MAP, "bag.map"},
-
-      /* BV */
-      {Op::BV_EXTRACT, "extract"},
-      {Op::BV_REPEAT, "repeat"},
-      {Op::BV_ROTATE_LEFT, "rotate_left"},
-      {Op::BV_ROTATE_RIGHT, "rotate_right"},
-      {Op::BV_SIGN_EXTEND, "sign_extend"},
-      {Op::BV_ZERO_EXTEND, "zero_extend"},
-
-      {Op::BV_ADD, "bvadd"},
-      {Op::BV_AND, "bvand"},
-      {Op::BV_ASHR, "bvashr"},
-      {Op::BV_COMP, "bvcomp"},
-      {Op::BV_CONCAT, "concat"},
-      {Op::BV_LSHR, "bvlshr"},
-      {Op::BV_MULT, "bvmul"},
-      {Op::BV_NAND, "bvnand"},
-      {Op::BV_NEG, "bvneg"},
-      {Op::BV_NOR, "bvnor"},
-      {Op::BV_NOT, "bvnot"},
-      {Op::BV_OR, "bvor"},
-      {Op::BV_SDIV, "bvsdiv"},
-      {Op::BV_SGE, "bvsge"},
-      {Op::BV_SGT, "bvsgt"},
-      {Op::BV_SHL, "bvshl"},
-      {Op::BV_SLE, "bvsle"},
-      {Op::BV_SLT, "bvslt"},
-      {Op::BV_SMOD, "bvsmod"},
-      {Op::BV_SREM, "bvsrem"},
-      {Op::BV_SUB, "bvsub"},
-      {Op::BV_UDIV, "bvudiv"},
-      {Op::BV_UGE, "bvuge"},
-      {Op::BV_UGT, "bvugt"},
-      {Op::BV_ULE, "bvule"},
-      {Op::BV_ULT, "bvult"},
-      {Op::BV_UREM, "bvurem"},
-      {Op::BV_XNOR, "bvxnor"},
-      {Op::BV_XOR, "bvxor"},
-
-      /* Datatypes */
-      {Op::DT_APPLY_TESTER, "is"},
-      {Op::DT_APPLY_UPDATER, "update"},
-      {Op::DT_MATCH, "match"},
-      {Op::DT_MATCH_BIND_CASE, ""},
-      {Op::DT_MATCH_CASE, ""},
-
-      /* FP */
-      {Op::FP_TO_FP_FROM_BV, "to_fp"},
-      {Op::FP_TO_FP_FROM_SBV, "to_fp"},
-      {Op::FP_TO_FP_FROM_FP, "to_fp"},
-      {Op::FP_TO_FP_FROM_UBV, "to_fp_unsigned"},
-      {Op::FP_TO_FP_FROM_REAL, "to_fp"},
-      {Op::FP_TO_SBV, "fp.to_sbv"},
-      {Op::FP_TO_UBV, "fp.to_ubv"},
-
-      {Op::FP_ABS, "fp.abs"},
-      {Op::FP_ADD, "fp.add"},
-      {Op::FP_DIV, "fp.div"},
-      {Op::FP_EQ, "fp.eq"},
-      {Op::FP_FMA, "fp.fma"},
-      {Op::FP_FP, "fp"},
-      {Op::FP_IS_NORMAL, "fp.isNormal"},
-      {Op::FP_IS_SUBNORMAL, "fp.isSubnormal"},
-      {Op::FP_IS_INF, "fp.isInfinite"},
-      {Op::FP_IS_NAN, "fp.isNaN"},
-      {Op::FP_IS_NEG, "fp.isNegative"},
-      {Op::FP_IS_POS, "fp.isPositive"},
-      {Op::FP_IS_ZERO, "fp.isZero"},
-      {Op::FP_LT, "fp.lt"},
-      {Op::FP_LEQ, "fp.leq"},
-      {Op::FP_GT, "fp.gt"},
-      {Op::FP_GEQ, "fp.geq"},
-      {Op::FP_MAX, "fp.max"},
-      {Op::FP_MIN, "fp.min"},
-      {Op::FP_MUL, "fp.mul"},
-      {Op::FP_NEG, "fp.neg"},
-      {Op::FP_REM, "fp.rem"},
-      {Op::FP_RTI, "fp.roundToIntegral"},
-      {Op::FP_SQRT, "fp.sqrt"},
-      {Op::FP_SUB, "fp.sub"},
-      {Op::FP_TO_REAL, "fp.to_real"},
-
-      /* Ints */
-      {Op::INT_IS_DIV, "divisible"},
-      {Op::INT_NEG, "-"},
-      {Op::INT_SUB, "-"},
-      {Op::INT_ADD, "+"},
-      {Op::INT_MUL, "*"},
-      {Op::INT_DIV, "div"},
-      {Op::INT_MOD, "mod"},
-      {Op::INT_ABS, "abs"},
-      {Op::INT_LT, "<"},
-      {Op::INT_LTE, "<="},
-      {Op::INT_GT, ">"},
-      {Op::INT_GTE, ">="},
-
-      /* Reals */
-      {Op::REAL_NEG, "-"},
-      {Op::REAL_SUB, "-"},
-      {Op::REAL_ADD, "+"},
-      {Op::REAL_MUL, "*"},
-      {Op::REAL_DIV, "/"},
-      {Op::REAL_LT, "<"},
-      {Op::REAL_LTE, "<="},
-      {Op::REAL_GT, ">"},
-      {Op::REAL_GTE, ">="},
-      {Op::REAL_IS_INT, "is_int"},
-
-      /* Reals and Ints */
-      {Op::INT_TO_REAL, "to_real"},
-      {Op::REAL_IS_INT, "is_int"},
-      {Op::REAL_TO_INT, "to_int"},
-
-      /* Quantifiers */
-      {Op::FORALL, "forall"},
-      {Op::EXISTS, "exists"},
-
-      /* Sequences */
-      {Op::SEQ_CONCAT, "seq.++"},
-      {Op::SEQ_LENGTH, "seq.len"},
-      {Op::SEQ_EXTRACT, "seq.extract"},
-      {Op::SEQ_UPDATE, "seq.update"},
-      {Op::SEQ_AT, "seq.at"},
-      {Op::SEQ_CONTAINS, "seq.contains"},
-      {Op::SEQ_INDEXOF, "seq.indexof"},
-      {Op::SEQ_REPLACE, "seq.replace"},
-      {Op::SEQ_REPLACE_ALL, "seq.replace_all"},
-      {Op::SEQ_REV, "seq.rev"},
-      {Op::SEQ_PREFIX, "seq.prefixof"},
-      {Op::SEQ_SUFFIX, "seq.suffixof"},
-      {Op::SEQ_UNIT, "seq.unit"},
-      {Op::SEQ_NTH, "seq.nth"},
-
-      /* Sets */
-      {Op::SET_CARD, "set.card"},
-      {Op::SET_COMPLEMENT, "set.complement"},
-      {Op::SET_COMPREHENSION, "set.comprehension"},
-      {Op::SET_CHOOSE, "set.choose"},
-      {Op::SET_INTERSECTION, "set.inter"},
-      {Op::SET_INSERT, "set.insert"},
-      {Op::SET_IS_SINGLETON, "set.is_singleton"},
-      {Op::SET_UNION, "set.union"},
-      {Op::SET_MEMBER, "set.member"},
-      {Op::SET_MINUS, "set.minus"},
-      {Op::SET_SINGLETON, "set.singleton"},
-      {Op::SET_SUBSET, "set.subset"},
-      /* Strings */
-      {Op::STR_CONCAT, "str.++"},
-      {Op::STR_LEN, "str.len"},
-      {Op::STR_LT, "str.<"},
-      {Op::STR_TO_RE, "str.to_re"},
-      {Op::STR_IN_RE, "str.in_re"},
-      {Op::STR_LE, "str.<="},
-      {Op::STR_AT, "str.at"},
-      {Op::STR_SUBSTR, "str.substr"},
-      {Op::STR_PREFIXOF, "str.prefixof"},
-      {Op::STR_SUFFIXOF, "str.suffixof"},
-      {Op::STR_CONTAINS, "str.contains"},
-      {Op::STR_INDEXOF, "str.indexof"},
-      {Op::STR_REPLACE, "str.replace"},
-      {Op::STR_REPLACE_ALL, "str.replace_all"},
-      {Op::STR_REPLACE_RE, "str.replace_re"},
-      {Op::STR_REPLACE_RE_ALL, "str.replace_re_all"},
-      {Op::STR_IS_DIGIT, "str.is_digit"},
-      {Op::STR_TO_CODE, "str.to_code"},
-      {Op::STR_FROM_CODE, "str.from_code"},
-      {Op::STR_TO_INT, "str.to_int"},
-      {Op::STR_FROM_INT, "str.from_int"},
-      {Op::RE_ALL, "re.all"},
-      {Op::RE_ALLCHAR, "re.allchar"},
-      {Op::RE_CONCAT, "re.++"},
-      {Op::RE_COMP, "re.comp"},
-      {Op::RE_DIFF, "re.diff"},
-      {Op::RE_INTER, "re.inter"},
-      {Op::RE_LOOP, "re.loop"},
-      {Op::RE_NONE, "re.none"},
-      {Op::RE_OPT, "re.opt"},
-      {Op::RE_PLUS, "re.+"},
-      {Op::RE_POW, "re.^"},
-      {Op::RE_RANGE, "re.range"},
-      {Op::RE_STAR, "re.*"},
-      {Op::RE_UNION, "re.union"},
-      /* Transcendentals */
-      {Op::TRANS_PI, "real.pi"},
-      {Op::TRANS_SINE, "sin"},
-      {Op::TRANS_COSINE, "cos"},
-      {Op::TRANS_TANGENT, "tan"},
-      {Op::TRANS_COTANGENT, "cot"},
-      {Op::TRANS_SECANT, "sec"},
-      {Op::TRANS_COSECANT, "csc"},
-      {Op::TRANS_ARCSINE, "arcsin"},
-      {Op::TRANS_ARCCOSINE, "arccos"},
-      {Op::TRANS_ARCTANGENT, "arctan"},
-      {Op::TRANS_ARCCOSECANT, "arccsc"},
-      {Op::TRANS_ARCSECANT, "arcsec"},
-      {Op::TRANS_ARCCOTANGENT, "arccot"},
-      {Op::TRANS_SQRT, "sqrt"},
-      /* UF */
-      {Op::UF_APPLY, ""},
+  /**
+   * Get the name of this term if it was named via define-fun in given epoch,
+   * nullptr otherwise.
+   */
+  const std::string* get_name(uint64_t epoch) const;
+
+  /** The cached result of get_repr() for non-leaf terms. */
+  mutable std::string d_repr_cache;
+  /** The epoch d_repr_cache was computed in. */
+  mutable uint64_t d_repr_epoch = 0;
+  /** The name of this term if named via define-fun. */
+  std::string d_name;
+  /** The epoch this term was named in, 0 if it is not named. */
+  uint64_t d_name_epoch = 0;
+  /** The epoch this term was last printed in, 0 if it was never printed. */
+  uint64_t d_printed_epoch = 0;
+  /** True if this term contains variables, computed on demand. */
+  bool d_has_vars = false;
+
+  /** Get the map from operator kinds to SMT-LIB operator symbols. */
+  static const std::unordered_map<std::string, std::string>& op_kind_to_str()
+  {
+    static const std::unordered_map<std::string, std::string> map = {
+        {Op::DISTINCT, "distinct"},
+        {Op::EQUAL, "="},
+        {Op::ITE, "ite"},
+
+        /* Boolean */
+        {Op::AND, "and"},
+        {Op::IFF, "="},
+        {Op::IMPLIES, "=>"},
+        {Op::NOT, "not"},
+        {Op::OR, "or"},
+        {Op::XOR, "xor"},
+
+        /* Arrays */
+        {Op::ARRAY_SELECT, "select"},
+        {Op::ARRAY_STORE, "store"},
+
+        /* Bags */
+        {Op::BAG_UNION_MAX, "bag.union_max"},
+        {Op::BAG_UNION_DISJOINT, "bag.union_disjoint"},
+        {Op::BAG_INTERSECTION_MIN, "bag.inter_min"},
+        {Op::BAG_DIFFERENCE_SUBTRACT, "bag.difference_subtract"},
+        {Op::BAG_DIFFERENCE_REMOVE, "bag.difference_remove"},
+        {Op::BAG_SUBBAG, "bag.subbag"},
+        {Op::BAG_COUNT, "bag.count"},
+        {Op::BAG_DUPLICATE_REMOVAL, "bag.duplicate_removal"},
+        {Op::BAG_MAKE, "bag"},
+        {Op::BAG_EMPTY, "bag.empty"},
+        {Op::BAG_CARD, "bag.card"},
+        {Op::BAG_CHOOSE, "bag.choose"},
+        {Op::BAG_IS_SINGLETON, "bag.is_singleton"},
+        {Op::BAG_FROM_SET, "bag.from_set"},
+        {Op::BAG_TO_SET, "bag.to_set"},
+        {Op::BAG_MAP, "bag.map"},
+
+        /* BV */
+        {Op::BV_EXTRACT, "extract"},
+        {Op::BV_REPEAT, "repeat"},
+        {Op::BV_ROTATE_LEFT, "rotate_left"},
+        {Op::BV_ROTATE_RIGHT, "rotate_right"},
+        {Op::BV_SIGN_EXTEND, "sign_extend"},
+        {Op::BV_ZERO_EXTEND, "zero_extend"},
+
+        {Op::BV_ADD, "bvadd"},
+        {Op::BV_AND, "bvand"},
+        {Op::BV_ASHR, "bvashr"},
+        {Op::BV_COMP, "bvcomp"},
+        {Op::BV_CONCAT, "concat"},
+        {Op::BV_LSHR, "bvlshr"},
+        {Op::BV_MULT, "bvmul"},
+        {Op::BV_NAND, "bvnand"},
+        {Op::BV_NEG, "bvneg"},
+        {Op::BV_NOR, "bvnor"},
+        {Op::BV_NOT, "bvnot"},
+        {Op::BV_OR, "bvor"},
+        {Op::BV_SDIV, "bvsdiv"},
+        {Op::BV_SGE, "bvsge"},
+        {Op::BV_SGT, "bvsgt"},
+        {Op::BV_SHL, "bvshl"},
+        {Op::BV_SLE, "bvsle"},
+        {Op::BV_SLT, "bvslt"},
+        {Op::BV_SMOD, "bvsmod"},
+        {Op::BV_SREM, "bvsrem"},
+        {Op::BV_SUB, "bvsub"},
+        {Op::BV_UDIV, "bvudiv"},
+        {Op::BV_UGE, "bvuge"},
+        {Op::BV_UGT, "bvugt"},
+        {Op::BV_ULE, "bvule"},
+        {Op::BV_ULT, "bvult"},
+        {Op::BV_UREM, "bvurem"},
+        {Op::BV_XNOR, "bvxnor"},
+        {Op::BV_XOR, "bvxor"},
+
+        /* Datatypes */
+        {Op::DT_APPLY_TESTER, "is"},
+        {Op::DT_APPLY_UPDATER, "update"},
+        {Op::DT_MATCH, "match"},
+        {Op::DT_MATCH_BIND_CASE, ""},
+        {Op::DT_MATCH_CASE, ""},
+
+        /* FP */
+        {Op::FP_TO_FP_FROM_BV, "to_fp"},
+        {Op::FP_TO_FP_FROM_SBV, "to_fp"},
+        {Op::FP_TO_FP_FROM_FP, "to_fp"},
+        {Op::FP_TO_FP_FROM_UBV, "to_fp_unsigned"},
+        {Op::FP_TO_FP_FROM_REAL, "to_fp"},
+        {Op::FP_TO_SBV, "fp.to_sbv"},
+        {Op::FP_TO_UBV, "fp.to_ubv"},
+
+        {Op::FP_ABS, "fp.abs"},
+        {Op::FP_ADD, "fp.add"},
+        {Op::FP_DIV, "fp.div"},
+        {Op::FP_EQ, "fp.eq"},
+        {Op::FP_FMA, "fp.fma"},
+        {Op::FP_FP, "fp"},
+        {Op::FP_IS_NORMAL, "fp.isNormal"},
+        {Op::FP_IS_SUBNORMAL, "fp.isSubnormal"},
+        {Op::FP_IS_INF, "fp.isInfinite"},
+        {Op::FP_IS_NAN, "fp.isNaN"},
+        {Op::FP_IS_NEG, "fp.isNegative"},
+        {Op::FP_IS_POS, "fp.isPositive"},
+        {Op::FP_IS_ZERO, "fp.isZero"},
+        {Op::FP_LT, "fp.lt"},
+        {Op::FP_LEQ, "fp.leq"},
+        {Op::FP_GT, "fp.gt"},
+        {Op::FP_GEQ, "fp.geq"},
+        {Op::FP_MAX, "fp.max"},
+        {Op::FP_MIN, "fp.min"},
+        {Op::FP_MUL, "fp.mul"},
+        {Op::FP_NEG, "fp.neg"},
+        {Op::FP_REM, "fp.rem"},
+        {Op::FP_RTI, "fp.roundToIntegral"},
+        {Op::FP_SQRT, "fp.sqrt"},
+        {Op::FP_SUB, "fp.sub"},
+        {Op::FP_TO_REAL, "fp.to_real"},
+
+        /* Ints */
+        {Op::INT_IS_DIV, "divisible"},
+        {Op::INT_NEG, "-"},
+        {Op::INT_SUB, "-"},
+        {Op::INT_ADD, "+"},
+        {Op::INT_MUL, "*"},
+        {Op::INT_DIV, "div"},
+        {Op::INT_MOD, "mod"},
+        {Op::INT_ABS, "abs"},
+        {Op::INT_LT, "<"},
+        {Op::INT_LTE, "<="},
+        {Op::INT_GT, ">"},
+        {Op::INT_GTE, ">="},
+
+        /* Reals */
+        {Op::REAL_NEG, "-"},
+        {Op::REAL_SUB, "-"},
+        {Op::REAL_ADD, "+"},
+        {Op::REAL_MUL, "*"},
+        {Op::REAL_DIV, "/"},
+        {Op::REAL_LT, "<"},
+        {Op::REAL_LTE, "<="},
+        {Op::REAL_GT, ">"},
+        {Op::REAL_GTE, ">="},
+        {Op::REAL_IS_INT, "is_int"},
+
+        /* Reals and Ints */
+        {Op::INT_TO_REAL, "to_real"},
+        {Op::REAL_IS_INT, "is_int"},
+        {Op::REAL_TO_INT, "to_int"},
+
+        /* Quantifiers */
+        {Op::FORALL, "forall"},
+        {Op::EXISTS, "exists"},
+
+        /* Sequences */
+        {Op::SEQ_CONCAT, "seq.++"},
+        {Op::SEQ_LENGTH, "seq.len"},
+        {Op::SEQ_EXTRACT, "seq.extract"},
+        {Op::SEQ_UPDATE, "seq.update"},
+        {Op::SEQ_AT, "seq.at"},
+        {Op::SEQ_CONTAINS, "seq.contains"},
+        {Op::SEQ_INDEXOF, "seq.indexof"},
+        {Op::SEQ_REPLACE, "seq.replace"},
+        {Op::SEQ_REPLACE_ALL, "seq.replace_all"},
+        {Op::SEQ_REV, "seq.rev"},
+        {Op::SEQ_PREFIX, "seq.prefixof"},
+        {Op::SEQ_SUFFIX, "seq.suffixof"},
+        {Op::SEQ_UNIT, "seq.unit"},
+        {Op::SEQ_NTH, "seq.nth"},
+
+        /* Sets */
+        {Op::SET_CARD, "set.card"},
+        {Op::SET_COMPLEMENT, "set.complement"},
+        {Op::SET_COMPREHENSION, "set.comprehension"},
+        {Op::SET_CHOOSE, "set.choose"},
+        {Op::SET_INTERSECTION, "set.inter"},
+        {Op::SET_INSERT, "set.insert"},
+        {Op::SET_IS_SINGLETON, "set.is_singleton"},
+        {Op::SET_UNION, "set.union"},
+        {Op::SET_MEMBER, "set.member"},
+        {Op::SET_MINUS, "set.minus"},
+        {Op::SET_SINGLETON, "set.singleton"},
+        {Op::SET_SUBSET, "set.subset"},
+        /* Strings */
+        {Op::STR_CONCAT, "str.++"},
+        {Op::STR_LEN, "str.len"},
+        {Op::STR_LT, "str.<"},
+        {Op::STR_TO_RE, "str.to_re"},
+        {Op::STR_IN_RE, "str.in_re"},
+        {Op::STR_LE, "str.<="},
+        {Op::STR_AT, "str.at"},
+        {Op::STR_SUBSTR, "str.substr"},
+        {Op::STR_PREFIXOF, "str.prefixof"},
+        {Op::STR_SUFFIXOF, "str.suffixof"},
+        {Op::STR_CONTAINS, "str.contains"},
+        {Op::STR_INDEXOF, "str.indexof"},
+        {Op::STR_REPLACE, "str.replace"},
+        {Op::STR_REPLACE_ALL, "str.replace_all"},
+        {Op::STR_REPLACE_RE, "str.replace_re"},
+        {Op::STR_REPLACE_RE_ALL, "str.replace_re_all"},
+        {Op::STR_IS_DIGIT, "str.is_digit"},
+        {Op::STR_TO_CODE, "str.to_code"},
+        {Op::STR_FROM_CODE, "str.from_code"},
+        {Op::STR_TO_INT, "str.to_int"},
+        {Op::STR_FROM_INT, "str.from_int"},
+        {Op::RE_ALL, "re.all"},
+        {Op::RE_ALLCHAR, "re.allchar"},
+        {Op::RE_CONCAT, "re.++"},
+        {Op::RE_COMP, "re.comp"},
+        {Op::RE_DIFF, "re.diff"},
+        {Op::RE_INTER, "re.inter"},
+        {Op::RE_LOOP, "re.loop"},
+        {Op::RE_NONE, "re.none"},
+        {Op::RE_OPT, "re.opt"},
+        {Op::RE_PLUS, "re.+"},
+        {Op::RE_POW, "re.^"},
+        {Op::RE_RANGE, "re.range"},
+        {Op::RE_STAR, "re.*"},
+        {Op::RE_UNION, "re.union"},
+        /* Transcendentals */
+        {Op::TRANS_PI, "real.pi"},
+        {Op::TRANS_SINE, "sin"},
+        {Op::TRANS_COSINE, "cos"},
+        {Op::TRANS_TANGENT, "tan"},
+        {Op::TRANS_COTANGENT, "cot"},
+        {Op::TRANS_SECANT, "sec"},
+        {Op::TRANS_COSECANT, "csc"},
+        {Op::TRANS_ARCSINE, "arcsin"},
+        {Op::TRANS_ARCCOSINE, "arccos"},
+        {Op::TRANS_ARCTANGENT, "arctan"},
+        {Op::TRANS_ARCCOSECANT, "arccsc"},
+        {Op::TRANS_ARCSECANT, "arcsec"},
+        {Op::TRANS_ARCCOTANGENT, "arccot"},
+        {Op::TRANS_SQRT, "sqrt"},
+        /* UF */
+        {Op::UF_APPLY, ""},
 #ifdef MURXLA_USE_CVC5
-      /* cvc5-specific operator kinds */
-      {cvc5::Cvc5Term::OP_BV_REDAND, "bvredand"},
-      {cvc5::Cvc5Term::OP_BV_REDOR, "bvredor"},
-      {cvc5::Cvc5Term::OP_INT_TO_BV, "int2bv"},
-      {cvc5::Cvc5Term::OP_BV_TO_NAT, "bv2nat"},
-      {cvc5::Cvc5Term::OP_INT_IAND, "iand"},
-      {cvc5::Cvc5Term::OP_INT_POW2, "int.pow2"},
-      {cvc5::Cvc5Term::OP_STRING_UPDATE, "str.update"},
-      {cvc5::Cvc5Term::OP_STRING_TOLOWER, "str.tolower"},
-      {cvc5::Cvc5Term::OP_STRING_TOUPPER, "str.toupper"},
-      {cvc5::Cvc5Term::OP_STRING_REV, "str.rev"},
+        /* cvc5-specific operator kinds */
+        {cvc5::Cvc5Term::OP_BV_REDAND, "bvredand"},
+        {cvc5::Cvc5Term::OP_BV_REDOR, "bvredor"},
+        {cvc5::Cvc5Term::OP_INT_TO_BV, "int2bv"},
+        {cvc5::Cvc5Term::OP_BV_TO_NAT, "bv2nat"},
+        {cvc5::Cvc5Term::OP_INT_IAND, "iand"},
+        {cvc5::Cvc5Term::OP_INT_POW2, "int.pow2"},
+        {cvc5::Cvc5Term::OP_STRING_UPDATE, "str.update"},
+        {cvc5::Cvc5Term::OP_STRING_TOLOWER, "str.tolower"},
+        {cvc5::Cvc5Term::OP_STRING_TOUPPER, "str.toupper"},
+        {cvc5::Cvc5Term::OP_STRING_REV, "str.rev"},
 #endif
+    };
+    return map;
+  }
+};
+
+/* -------------------------------------------------------------------------- */
+/* Smt2OnlineSolverPool                                                       */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A pool of long-lived online solver processes.
+ *
+ * The pool is owned by the parent process.  Before forking a test run, the
+ * parent checks out a solver process, which is then picked up by the
+ * Smt2Solver instance of the test run process (see take()).  The test run
+ * process talks to the solver via the inherited pipes, thus a crash of the
+ * online solver is still attributed to the seed of this test run.  After the
+ * test run, the parent either resets the solver via (reset) and returns it to
+ * the pool, or kills it.
+ */
+class Smt2OnlineSolverPool
+{
+ public:
+  /** An online solver process and the pipes to communicate with it. */
+  struct Process
+  {
+    /** The pid of the solver process, 0 if not running. */
+    pid_t d_pid = 0;
+    /** The write end of the pipe connected to stdin of the solver. */
+    int32_t d_fd_to = -1;
+    /** The read end of the pipe connected to stdout/stderr of the solver. */
+    int32_t d_fd_from = -1;
   };
+
+  /**
+   * Spawn a new online solver process.
+   * solver_call: The solver binary and its arguments, separated by spaces.
+   */
+  static Process spawn(const std::string& solver_call);
+
+  /**
+   * Constructor.
+   * solver_call: The solver binary and its arguments, separated by spaces.
+   */
+  Smt2OnlineSolverPool(const std::string& solver_call);
+  /** Destructor, kills all solver processes of this pool. */
+  ~Smt2OnlineSolverPool();
+
+  /**
+   * Check out a solver process for the next test run.  Reuses an idle solver
+   * process if possible, else spawns a new one.  Called by the parent process
+   * before forking the test run process.
+   */
+  void checkout();
+
+  /**
+   * Take the checked out solver process.  Called in the test run process.
+   * Returns a process with pid 0 if no process is checked out.
+   */
+  Process take();
+
+  /**
+   * Return the checked out solver process after the test run.
+   * reuse: True if the test run terminated normally, in which case the solver
+   *        is reset and returned to the pool.  Else, the solver is killed.
+   */
+  void checkin(bool reuse);
+
+  /**
+   * Notify the pool that process 'pid' has been reaped by the parent process.
+   * Returns true if 'pid' was a solver process of this pool.
+   */
+  bool reaped(pid_t pid);
+
+ private:
+  /**
+   * Reset given solver process via (reset) and wait until it responded.
+   * Returns false if the solver did not respond within MURXLA_SMT2_RESET_TIME
+   * seconds.
+   */
+  bool reset(const Process& process);
+  /** Kill and reap given solver process and close its pipes. */
+  static void kill_process(Process& process);
+
+  static constexpr int32_t SMT2_READ_END  = 0;
+  static constexpr int32_t SMT2_WRITE_END = 1;
+
+  /** The solver binary and its arguments. */
+  std::string d_solver_call;
+  /** The idle solver processes. */
+  std::vector<Process> d_idle;
+  /** The currently checked out solver process. */
+  Process d_checked_out;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -390,9 +517,24 @@ class Smt2Term : public AbsTerm
 class Smt2Solver : public Solver
 {
  public:
+  /**
+   * Constructor.
+   * sng            : The associated solver seed generator.
+   * out            : The output stream to dump SMT-LIB commands to.
+   * solver_binary  : The online solver call, empty for offline mode.
+   * pipeline       : True to stream commands to the online solver without
+   *                  waiting for a response (see push_to_external()).
+   * trace_responses: True to echo the responses of the online solver as
+   *                  comments to the SMT2 output.
+   * pool           : The pool of online solver processes to take the solver
+   *                  process from, nullptr to spawn a new process.
+   */
   Smt2Solver(SolverSeedGenerator& sng,
              std::ostream& out,
-             const std::string& solver_binary);
+             const std::string& solver_binary,
+             bool pipeline = false,
+             bool trace_responses = false,
+             Smt2OnlineSolverPool* pool = nullptr);
   ~Smt2Solver() override;
 
   void new_solver() override;
@@ -486,14 +628,70 @@ class Smt2Solver : public Solver
     SMT2_SEXPR,
   };
 
+  /**
+   * Send command to the online solver and check its response.
+   *
+   * In pipeline mode, commands that expect a 'success' response are only
+   * buffered (print-success is disabled), and the solver is only synchronized
+   * with on queries (check-sat, get-value, get-model, ...).  Errors reported
+   * for streamed commands are detected via check_external_errors() and at the
+   * next synchronization point.
+   */
+  /**
+   * Get the SMT-LIB representation of a term to be printed in a command.
+   *
+   * Non-leaf subterms that are shared, either within this term or with terms
+   * printed in previous commands, are named via define-fun before, and are
+   * referred to by name.  This avoids printing the same subterm over and
+   * over, thus printing the terms of a run is linear in the number of
+   * distinct terms.  Subterms that contain variables are not named, but bound
+   * via let binders.
+   */
+  const std::string& get_smt2_repr(const Term& term);
+  /** Name the shared subterms of given term via define-fun. */
+  void define_shared_terms(Smt2Term* term);
+
   void push_to_external(std::string s, ResponseKind expected);
-  std::string get_from_external() const;
+  /**
+   * Read one response line or s-expression from the online solver.
+   *
+   * The response is read into d_read_buf, the returned view is only valid
+   * until the next call.
+   *
+   * echo: True to echo the response as comment to the SMT2 output if
+   *       d_trace_responses is enabled.
+   */
+  std::string_view get_from_external(bool echo = true);
+  /**
+   * Read all responses the online solver already sent without blocking.
+   * Only used in pipeline mode, where any pending response must be an error.
+   */
+  void check_external_errors();
+  /**
+   * Exit with an error if response 'res' of the online solver indicates an
+   * error or that the solver terminated.
+   */
+  void check_external_response(std::string_view res) const;
+  /**
+   * Flush all streamed commands and wait until the online solver processed
+   * them.  Only used in pipeline mode.
+   */
+  void sync_external();
   void dump_smt2(std::string s,
                  ResponseKind expected = ResponseKind::SMT2_SUCCESS);
   std::ostream& d_out = std::cout;
   bool d_online       = false;
+  bool d_pipeline     = false;
   FILE* d_file_to     = nullptr;
-  FILE* d_file_from   = nullptr;
+
+  /** True to echo responses of the online solver to d_out. */
+  bool d_trace_responses = false;
+  /** The read end of the pipe connected to stdout of the online solver. */
+  int32_t d_fd_from = -1;
+  /** The buffer for reading responses of the online solver. */
+  std::string d_read_buf;
+  /** The end of the last response returned by get_from_external(). */
+  size_t d_read_pos = 0;
 
   bool d_initialized               = false;
   bool d_incremental               = false;
@@ -504,13 +702,21 @@ class Smt2Solver : public Solver
   uint32_t d_n_unnamed_ufs         = 0;
   uint32_t d_n_unnamed_vars        = 0;
   uint64_t d_define_sort_param_cnt = 0;
+  uint64_t d_n_named_terms         = 0;
   Solver::Result d_last_result     = Solver::Result::UNKNOWN;
 
-  static constexpr int32_t SMT2_READ_END  = 0;
-  static constexpr int32_t SMT2_WRITE_END = 1;
+  /** The naming epoch, incremented on reset, which invalidates all names. */
+  uint64_t d_epoch = 1;
+
+  /** The number of bytes to read from the online solver at once. */
+  static constexpr size_t SMT2_READ_SIZE = 1 << 16;
 
   pid_t d_online_pid = 0;
   std::string d_solver_call;
+  /** The pool of online solver processes, nullptr if not used. */
+  Smt2OnlineSolverPool* d_pool = nullptr;
+  /** True if the online solver process was taken from d_pool. */
+  bool d_pooled = false;
   std::unordered_map<std::string, std::string> d_sort_fun_map;
 };
 
@@ -7,10 +7,9 @@ namespace murxla {
 
 using namespace nlohmann;
 
-SolverProfile::SolverProfile(const std::string& json_str) : d_json_str(json_str)
+SolverProfile::SolverProfile(const std::string& json_str)
+    : d_json(parse(json_str))
 {
-  parse();
-
   for (int32_t i = 0; i < THEORY_ALL; ++i)
   {
     std::stringstream ss;
@@ -26,6 +25,8 @@ SolverProfile::SolverProfile(const std::string& json_str) : d_json_str(json_str)
     ss << sk;
     d_str_to_sort_kind.emplace(ss.str(), sk);
   }
+
+  compile();
 }
 
 namespace {
@@ -101,251 +102,304 @@ merge_json(json& merged, json& other, const std::string& key = "")
 std::string
 SolverProfile::merge(const std::string& json_str1, const std::string& json_str2)
 {
-  SolverProfile p1(json_str1);
-  SolverProfile p2(json_str2);
-  json j1 = p1.d_json;
-  json j2 = p2.d_json;
+  /* Only parse, the given profiles may be partial profiles that can not be
+   * compiled on their own. */
+  json j1 = parse(json_str1);
+  json j2 = parse(json_str2);
 
   merge_json(j1, j2);
   return j1.dump();
 }
 
-TheoryVector
+const TheoryVector&
 SolverProfile::get_supported_theories() const
 {
-  TheorySet solver_theories;
-  for (const std::string& t : get_array({KEY_THEORIES, "include"}, true))
-  {
-    solver_theories.insert(to_theory(t));
-  }
-  // THEORY_BOOL is always enabled.
-  solver_theories.insert(THEORY_BOOL);
-
-  return TheoryVector(solver_theories.begin(), solver_theories.end());
+  return d_supported_theories;
 }
 
-std::unordered_map<Theory, std::vector<Theory>>
+const std::unordered_map<Theory, std::vector<Theory>>&
 SolverProfile::get_unsupported_theory_combinations() const
 {
-  std::unordered_map<Theory, std::vector<Theory>> unsupported;
-
-  auto it = d_json.find(KEY_THEORIES);
-  if (it != d_json.end())
-  {
-    auto itt = it->find(KEY_THEORY_COMBINATIONS);
-    if (itt != it->end())
-    {
-      for (auto i = itt->begin(); i != itt->end(); ++i)
-      {
-        Theory tid = to_theory(i.key());
-        MURXLA_EXIT_ERROR(!i.value().is_array())
-            << "Expected list for " << KEY_THEORIES
-            << "::" << KEY_THEORY_COMBINATIONS << "::" << tid;
-        std::unordered_set<Theory> theories;
-        for (const auto& t : i.value())
-        {
-          Theory tid = to_theory(t.get<std::string>());
-          MURXLA_EXIT_ERROR(tid == THEORY_BOOL)
-              << tid << " cannot be excluded.";
-          theories.insert(tid);
-        }
-        unsupported.emplace(
-            tid, std::vector<Theory>(theories.begin(), theories.end()));
-      }
-    }
-  }
-  return unsupported;
+  return d_unsupported_theory_combinations;
 }
 
-OpKindSet
+const OpKindSet&
 SolverProfile::get_unsupported_op_kinds() const
 {
-  OpKindSet unsupported;
-  if (has_key(KEY_OPERATORS))
-  {
-    auto kinds = get_array({KEY_OPERATORS, "exclude"});
-    unsupported.insert(kinds.begin(), kinds.end());
-    // TODO: include
-  }
-  return unsupported;
+  return d_unsupported_op_kinds;
 }
 
-SolverProfile::OpKindSortKindMap
+const SolverProfile::OpKindSortKindMap&
 SolverProfile::get_unsupported_op_sort_kinds() const
 {
-  auto it = d_json.find(KEY_OPERATORS);
-  if (it == d_json.end())
-  {
-    return d_default_unsupported_op_sort_kinds;
-  }
-  auto itt = it->find(KEY_SORT_RESTR);
-  if (itt == it->end())
-  {
-    return d_default_unsupported_op_sort_kinds;
-  }
-  MURXLA_EXIT_ERROR(!itt->is_object())
-      << "Expected JSON object for `" << KEY_SORT_RESTR << "'";
-
-  OpKindSortKindMap unsupported;
-  for (auto i = itt->begin(); i != itt->end(); ++i)
-  {
-    Op::Kind k = i.key();
-    MURXLA_EXIT_ERROR(!i.value().is_array())
-        << "Expected list for " << KEY_OPERATORS << "::" << KEY_SORT_RESTR
-        << "::" << k;
-    SortKindSet sks;
-    for (const auto& sk : i.value())
-    {
-      sks.insert(to_sort_kind(sk.get<std::string>()));
-    }
-    unsupported.emplace(k, sks);
-  }
-  return unsupported;
+  return d_unsupported_op_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "exclude"});
+  return d_unsupported_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_var_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "var", "exclude"});
+  return d_unsupported_var_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_array_index_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "array-index", "exclude"});
+  return d_unsupported_array_index_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_array_element_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "array-element", "exclude"});
+  return d_unsupported_array_element_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_bag_element_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "bag-element", "exclude"});
+  return d_unsupported_bag_element_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_dt_match_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "datatype-match", "exclude"});
+  return d_unsupported_dt_match_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_dt_sel_codomain_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "datatype-selector-codomain", "exclude"});
+  return d_unsupported_dt_sel_codomain_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_fun_codomain_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "fun-codomain", "exclude"});
+  return d_unsupported_fun_codomain_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_fun_domain_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "fun-domain", "exclude"});
+  return d_unsupported_fun_domain_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_fun_sort_codomain_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "fun-sort-codomain", "exclude"});
+  return d_unsupported_fun_sort_codomain_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_fun_sort_domain_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "fun-sort-domain", "exclude"});
+  return d_unsupported_fun_sort_domain_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_get_value_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "get-value", "exclude"});
+  return d_unsupported_get_value_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_seq_element_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "seq-element", "exclude"});
+  return d_unsupported_seq_element_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_set_element_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "set-element", "exclude"});
+  return d_unsupported_set_element_sort_kinds;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_sort_param_sort_kinds() const
 {
-  return get_sort_kinds({KEY_SORTS, "sort-param", "exclude"});
+  return d_unsupported_sort_param_sort_kinds;
 }
 
-std::vector<std::string>
+const std::vector<std::string>&
 SolverProfile::get_excluded_errors() const
 {
-  std::vector<std::string> errors;
-  // Load excluded errors
-  auto it = d_json.find(KEY_ERRORS);
+  return d_excluded_errors;
+}
+
+const std::vector<std::string>&
+SolverProfile::get_error_filters() const
+{
+  return d_error_filters;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void
+SolverProfile::compile()
+{
+  d_supported_theories              = get_theories();
+  d_unsupported_theory_combinations = get_theory_combinations();
+  if (has_key(KEY_OPERATORS))
+  {
+    auto kinds = get_array({KEY_OPERATORS, "exclude"});
+    d_unsupported_op_kinds.insert(kinds.begin(), kinds.end());
+    // TODO: include
+  }
+  d_unsupported_op_sort_kinds = get_op_sort_kinds();
+
+  d_unsupported_sort_kinds = get_sort_kinds({KEY_SORTS, "exclude"});
+  d_unsupported_var_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "var", "exclude"});
+  d_unsupported_array_index_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "array-index", "exclude"});
+  d_unsupported_array_element_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "array-element", "exclude"});
+  d_unsupported_bag_element_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "bag-element", "exclude"});
+  d_unsupported_dt_match_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "datatype-match", "exclude"});
+  d_unsupported_dt_sel_codomain_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "datatype-selector-codomain", "exclude"});
+  d_unsupported_fun_codomain_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "fun-codomain", "exclude"});
+  d_unsupported_fun_domain_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "fun-domain", "exclude"});
+  d_unsupported_fun_sort_codomain_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "fun-sort-codomain", "exclude"});
+  d_unsupported_fun_sort_domain_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "fun-sort-domain", "exclude"});
+  d_unsupported_get_value_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "get-value", "exclude"});
+  d_unsupported_seq_element_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "seq-element", "exclude"});
+  d_unsupported_set_element_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "set-element", "exclude"});
+  d_unsupported_sort_param_sort_kinds =
+      get_sort_kinds({KEY_SORTS, "sort-param", "exclude"});
+
+  d_excluded_errors = get_errors("exclude");
+  d_error_filters   = get_errors("filter");
+}
+
+TheoryVector
+SolverProfile::get_theories() const
+{
+  TheorySet solver_theories;
+  for (const std::string& t : get_array({KEY_THEORIES, "include"}, true))
+  {
+    solver_theories.insert(to_theory(t));
+  }
+  // THEORY_BOOL is always enabled.
+  solver_theories.insert(THEORY_BOOL);
+
+  return TheoryVector(solver_theories.begin(), solver_theories.end());
+}
+
+std::unordered_map<Theory, std::vector<Theory>>
+SolverProfile::get_theory_combinations() const
+{
+  std::unordered_map<Theory, std::vector<Theory>> unsupported;
+
+  auto it = d_json.find(KEY_THEORIES);
   if (it != d_json.end())
   {
-    auto itt = it->find("exclude");
-    if (itt != it->end() && itt->is_array())
+    auto itt = it->find(KEY_THEORY_COMBINATIONS);
+    if (itt != it->end())
     {
-      for (const auto& err : *itt)
+      for (auto i = itt->begin(); i != itt->end(); ++i)
       {
-        errors.emplace_back(err.get<std::string>());
+        Theory tid = to_theory(i.key());
+        MURXLA_EXIT_ERROR(!i.value().is_array())
+            << "Expected list for " << KEY_THEORIES
+            << "::" << KEY_THEORY_COMBINATIONS << "::" << tid;
+        std::unordered_set<Theory> theories;
+        for (const auto& t : i.value())
+        {
+          Theory tid = to_theory(t.get<std::string>());
+          MURXLA_EXIT_ERROR(tid == THEORY_BOOL)
+              << tid << " cannot be excluded.";
+          theories.insert(tid);
+        }
+        unsupported.emplace(
+            tid, std::vector<Theory>(theories.begin(), theories.end()));
       }
     }
   }
-  return errors;
+  return unsupported;
+}
+
+SolverProfile::OpKindSortKindMap
+SolverProfile::get_op_sort_kinds() const
+{
+  auto it = d_json.find(KEY_OPERATORS);
+  if (it == d_json.end())
+  {
+    return d_default_unsupported_op_sort_kinds;
+  }
+  auto itt = it->find(KEY_SORT_RESTR);
+  if (itt == it->end())
+  {
+    return d_default_unsupported_op_sort_kinds;
+  }
+  MURXLA_EXIT_ERROR(!itt->is_object())
+      << "Expected JSON object for `" << KEY_SORT_RESTR << "'";
+
+  OpKindSortKindMap unsupported;
+  for (auto i = itt->begin(); i != itt->end(); ++i)
+  {
+    Op::Kind k = i.key();
+    MURXLA_EXIT_ERROR(!i.value().is_array())
+        << "Expected list for " << KEY_OPERATORS << "::" << KEY_SORT_RESTR
+        << "::" << k;
+    SortKindSet sks;
+    for (const auto& sk : i.value())
+    {
+      sks.insert(to_sort_kind(sk.get<std::string>()));
+    }
+    unsupported.emplace(k, sks);
+  }
+  return unsupported;
 }
 
 std::vector<std::string>
-SolverProfile::get_error_filters() const
+SolverProfile::get_errors(const std::string& key) const
 {
-  std::vector<std::string> filters;
-  // Load error filters
+  std::vector<std::string> errors;
   auto it = d_json.find(KEY_ERRORS);
   if (it != d_json.end())
   {
-    auto itt = it->find("filter");
+    auto itt = it->find(key);
     if (itt != it->end() && itt->is_array())
     {
       for (const auto& err : *itt)
       {
-        filters.emplace_back(err.get<std::string>());
+        errors.emplace_back(err.get<std::string>());
       }
     }
   }
-  return filters;
+  return errors;
 }
 
-void
-SolverProfile::parse()
+nlohmann::json
+SolverProfile::parse(const std::string& json_str)
 {
-  MURXLA_EXIT_ERROR_CONFIG(d_json_str.empty() || d_json_str == "{}")
+  MURXLA_EXIT_ERROR_CONFIG(json_str.empty() || json_str == "{}")
       << "Specified solver profile is empty.";
+  nlohmann::json res;
   try
   {
-    d_json = nlohmann::json::parse(d_json_str);
+    res = nlohmann::json::parse(json_str);
   }
   catch (const nlohmann::detail::parse_error& e)
   {
     MURXLA_EXIT_ERROR(true) << e.what() << std::endl;
   }
+  return res;
 }
 
 bool
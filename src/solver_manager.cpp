@@ -10,6 +10,7 @@
 #include "solver_manager.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <iterator>
 #include <sstream>
@@ -31,11 +32,13 @@ SolverManager::SolverManager(Solver* solver,
                              SolverOptions& options,
                              bool arith_linear,
                              bool simple_symbols,
+                             double perf_time,
                              statistics::Statistics* stats,
                              const TheoryVector& enabled_theories,
                              const TheorySet& disabled_theories)
     : d_arith_linear(arith_linear),
       d_simple_symbols(simple_symbols),
+      d_perf_time(perf_time),
       d_mbt_stats(stats),
       d_solver(solver),
       d_rng(rng),
@@ -547,8 +550,12 @@ SolverManager::pick_op_kind(bool with_terms, SortKind sort_kind)
         theory = THEORY_BOOL;
       }
 
-      auto& op_kinds  = kinds[theory];
-      return d_rng.pick_from_set<decltype(op_kinds), Op::Kind>(op_kinds);
+      auto& op_kinds = kinds[theory];
+      if (d_op_weights.empty())
+      {
+        return d_rng.pick_from_set<decltype(op_kinds), Op::Kind>(op_kinds);
+      }
+      return pick_weighted_op_kind(op_kinds);
     }
 
     /* We cannot create any operation with the current set of terms. */
@@ -572,6 +579,33 @@ SolverManager::pick_op_kind(bool with_terms, SortKind sort_kind)
   return d_rng.pick_from_set<decltype(kinds), Op::Kind>(kinds);
 }
 
+void
+SolverManager::set_op_weights(const std::vector<double>& factors)
+{
+  d_op_weights = factors;
+}
+
+Op::Kind
+SolverManager::pick_weighted_op_kind(const OpKindSet& op_kinds)
+{
+  /* Sort the candidates by id, the iteration order of the set must not
+   * influence which operator kind is picked for a given seed. */
+  std::vector<std::pair<uint64_t, Op::Kind>> ops;
+  for (const auto& kind : op_kinds)
+  {
+    ops.emplace_back(d_opmgr->get_op(kind).d_id, kind);
+  }
+  std::sort(ops.begin(), ops.end());
+
+  std::vector<uint32_t> weights;
+  for (const auto& [id, kind] : ops)
+  {
+    double f = id < d_op_weights.size() ? d_op_weights[id] : 1.0;
+    weights.push_back(static_cast<uint32_t>(std::lround(f * 100)));
+  }
+  return ops[d_rng.pick_weighted<uint32_t>(weights)].second;
+}
+
 Op&
 SolverManager::get_op(const Op::Kind& kind)
 {
@@ -770,7 +804,18 @@ SolverManager::report_result(Solver::Result res)
   d_sat_result = res;
   d_sat_called = true;
   ++d_n_sat_calls;
-  ++d_mbt_stats->d_results[res];
+  ++d_mbt_stats->shard().d_results[res];
+}
+
+void
+SolverManager::check_perf(const std::string& action, double time) const
+{
+  if (d_perf_time > 0)
+  {
+    MURXLA_TEST(time <= d_perf_time)
+        << "performance anomaly: '" << action << "' took " << time
+        << "s, time limit is " << d_perf_time << "s";
+  }
 }
 
 std::unordered_map<std::string, std::string>
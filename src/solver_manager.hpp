@@ -59,6 +59,7 @@ class SolverManager
                 SolverOptions& options,
                 bool arith_linear,
                 bool simple_symbols,
+                double perf_time,
                 statistics::Statistics* stats,
                 const TheoryVector& enabled_theories,
                 const TheorySet& disabled_theories);
@@ -281,6 +282,14 @@ class SolverManager
    */
   Op::Kind pick_op_kind(bool with_terms = true, SortKind sort_kind = SORT_ANY);
 
+  /**
+   * Set the weight factors of operator kinds picked via pick_op_kind().
+   * @param factors The weight factors, indexed by operator id. Operators
+   *                without factor are weighted with 1.  If empty, operator
+   *                kinds are picked uniformly.
+   */
+  void set_op_weights(const std::vector<double>& factors);
+
   /**
    * Get the Op data for given operator kind.
    * @param kind The operator kind.
@@ -775,6 +784,14 @@ class SolverManager
    */
   void report_result(Solver::Result res);
 
+  /**
+   * Check the time of a satisfiability check against the performance anomaly
+   * time limit (see --perf-time).
+   * @param action The kind of the action that performed the check.
+   * @param time   The time in seconds the check took.
+   */
+  void check_perf(const std::string& action, double time) const;
+
   /**
    * Get the currently configured solver profile.
    * @return The solver profile.
@@ -798,6 +815,13 @@ class SolverManager
    */
   bool d_simple_symbols = false;
 
+  /**
+   * The time limit in seconds for a single satisfiability check, a check
+   * that exceeds this limit is reported as performance anomaly. 0 if
+   * disabled.
+   */
+  double d_perf_time = 0;
+
   /* Solver (config) state --------------------------------------------------
    *
    *  All members below are reset / cleared on reset().
@@ -966,6 +990,12 @@ class SolverManager
             typename TKindMap>
   TKindData& pick_kind(TKindMap& map);
 
+  /**
+   * Pick an operator kind from the given set, weighted by the factors set via
+   * set_op_weights().
+   */
+  Op::Kind pick_weighted_op_kind(const OpKindSet& op_kinds);
+
   /**
    * The activated solver.
    * No calls to the API of the underlying solver are issued from the solver
@@ -1000,6 +1030,9 @@ class SolverManager
   /** The Op::Kind manager. */
   std::unique_ptr<OpKindManager> d_opmgr;
 
+  /** The weight factors of operator kinds, indexed by operator id. */
+  std::vector<double> d_op_weights;
+
   /** The set of enabled theories. */
   TheorySet d_enabled_theories;
 
@@ -9,12 +9,174 @@
  */
 #include "statistics.hpp"
 
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <new>
+#include <numeric>
+#include <sstream>
+
+#include "except.hpp"
 #include "op.hpp"
 #include "solver/solver.hpp"
 
 namespace murxla {
 namespace statistics {
 
+void
+Histogram::add(uint64_t ns)
+{
+  /* Bucket i holds latencies in [2^i, 2^(i+1)). */
+  size_t bucket = ns == 0 ? 0 : 63 - __builtin_clzll(ns);
+  ++d_buckets[std::min<size_t>(bucket, MURXLA_STATS_N_BUCKETS - 1)];
+  d_total_ns.add(ns);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void
+StatisticsShard::reset_cur()
+{
+  d_cur_action     = -1;
+  d_cur_op         = -1;
+  d_cur_action_idx = 0;
+}
+
+void
+StatisticsShard::set_cur_action(uint64_t id)
+{
+  d_cur_action = static_cast<int32_t>(id);
+  d_cur_op     = -1;
+  d_cur_action_idx += 1;
+}
+
+void
+StatisticsShard::set_cur_op(uint64_t id)
+{
+  d_cur_op = static_cast<int32_t>(id);
+}
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/** Format given time in nanoseconds with a human readable unit. */
+std::string
+format_ns(double ns)
+{
+  static const char* units[] = {"ns", "us", "ms", "s"};
+  size_t unit = 0;
+  while (ns >= 1000 && unit < 3)
+  {
+    ns /= 1000;
+    unit += 1;
+  }
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(unit == 0 ? 0 : 1) << ns
+     << units[unit];
+  return ss.str();
+}
+
+/**
+ * Get the upper bound of the bucket of histogram 'buckets' that contains the
+ * given quantile.
+ */
+uint64_t
+get_quantile(const std::vector<uint64_t>& buckets, uint64_t count, double q)
+{
+  uint64_t n = 0;
+  for (size_t b = 0; b < buckets.size(); ++b)
+  {
+    n += buckets[b];
+    if (static_cast<double>(n) >= q * static_cast<double>(count))
+    {
+      return uint64_t(1) << (b + 1);
+    }
+  }
+  return uint64_t(1) << buckets.size();
+}
+
+/** Print latency histogram with given name. */
+void
+print_latency(const std::string& name,
+              const std::vector<uint64_t>& buckets,
+              uint64_t total_ns)
+{
+  uint64_t count = std::accumulate(buckets.begin(), buckets.end(), uint64_t(0));
+  if (count == 0) return;
+  double total = static_cast<double>(total_ns);
+  double p50   = static_cast<double>(get_quantile(buckets, count, 0.5));
+  double p99   = static_cast<double>(get_quantile(buckets, count, 0.99));
+  std::cout << "  " << name << ": " << count << " calls, total "
+            << format_ns(total) << ", mean "
+            << format_ns(total / static_cast<double>(count)) << ", p50 < "
+            << format_ns(p50) << ", p99 < " << format_ns(p99) << std::endl;
+}
+
+/** Get latency histogram in JSON format. */
+nlohmann::json
+latency_to_json(const std::vector<uint64_t>& buckets, uint64_t total_ns)
+{
+  nlohmann::json res;
+  res["total_ns"] = total_ns;
+  res["buckets"]  = buckets;
+  return res;
+}
+
+/** The size of the statistics header, rounded up to a full cache line. */
+size_t
+header_size()
+{
+  return (sizeof(Statistics) + MURXLA_CACHE_LINE_SIZE - 1)
+         / MURXLA_CACHE_LINE_SIZE * MURXLA_CACHE_LINE_SIZE;
+}
+
+}  // namespace
+
+Statistics*
+Statistics::create(uint32_t n_shards)
+{
+  assert(n_shards > 0);
+  size_t size = header_size() + n_shards * sizeof(StatisticsShard);
+  void* mem   = mmap(
+      0, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_SHARED, -1, 0);
+  MURXLA_EXIT_ERROR(mem == MAP_FAILED)
+      << "failed to map shared memory for statistics";
+
+  Statistics* stats = new (mem) Statistics();
+  stats->d_n_shards = n_shards;
+  stats->d_shards   = new (static_cast<char*>(mem) + header_size())
+      StatisticsShard[n_shards]();
+  return stats;
+}
+
+int32_t
+Statistics::destroy(Statistics* stats)
+{
+  size_t size = header_size() + stats->d_n_shards * sizeof(StatisticsShard);
+  return munmap(stats, size);
+}
+
+uint64_t
+Statistics::get_num_results(uint32_t result) const
+{
+  return aggregate(&StatisticsShard::d_results, result);
+}
+
+uint64_t
+Statistics::get_num_actions(uint64_t id) const
+{
+  return aggregate(&StatisticsShard::d_actions, id);
+}
+
+uint64_t
+Statistics::get_num_ops(uint64_t id) const
+{
+  return aggregate(&StatisticsShard::d_ops, id);
+}
+
 void
 Statistics::print() const
 {
@@ -25,8 +187,9 @@ Statistics::print() const
   std::cout << "States:" << std::endl;
   for (uint32_t i = 0; i < MURXLA_MAX_N_STATES && d_state_kinds[i][0]; ++i)
   {
-    std::cout << "  " << d_state_kinds[i] << ": " << d_states[i] << std::endl;
-    sum += d_states[i];
+    uint64_t n = aggregate(&StatisticsShard::d_states, i);
+    std::cout << "  " << d_state_kinds[i] << ": " << n << std::endl;
+    sum += n;
   }
   std::cout << "  Total: " << sum << std::endl;
 
@@ -34,10 +197,12 @@ Statistics::print() const
   std::cout << "Actions:" << std::endl;
   for (uint32_t i = 0; i < MURXLA_MAX_N_ACTIONS && d_action_kinds[i][0]; ++i)
   {
-    std::cout << "  " << d_action_kinds[i] << ": " << d_actions[i] << " ("
-              << d_actions_ok[i] << ")" << std::endl;
-    sum += d_actions[i];
-    sum_ok += d_actions_ok[i];
+    uint64_t n    = aggregate(&StatisticsShard::d_actions, i);
+    uint64_t n_ok = aggregate(&StatisticsShard::d_actions_ok, i);
+    std::cout << "  " << d_action_kinds[i] << ": " << n << " (" << n_ok << ")"
+              << std::endl;
+    sum += n;
+    sum_ok += n_ok;
   }
   std::cout << "  Total: " << sum << " (" << sum_ok << ")" << std::endl;
 
@@ -45,9 +210,10 @@ Statistics::print() const
   std::cout << "Results:" << std::endl;
   for (uint32_t i = 0; i < 3; ++i)
   {
-    std::cout << "  " << static_cast<Solver::Result>(i) << ": " << d_results[i]
+    uint64_t n = aggregate(&StatisticsShard::d_results, i);
+    std::cout << "  " << static_cast<Solver::Result>(i) << ": " << n
               << std::endl;
-    sum += d_results[i];
+    sum += n;
   }
   std::cout << "  Total: " << sum << std::endl;
 
@@ -55,10 +221,12 @@ Statistics::print() const
   std::cout << "Ops:" << std::endl;
   for (uint32_t i = 0; i < MURXLA_MAX_N_OPS && d_op_kinds[i][0]; ++i)
   {
-    std::cout << "  " << d_op_kinds[i] << ": " << d_ops[i] << " ("
-              << d_ops_ok[i] << ")" << std::endl;
-    sum += d_ops[i];
-    sum_ok += d_ops_ok[i];
+    uint64_t n    = aggregate(&StatisticsShard::d_ops, i);
+    uint64_t n_ok = aggregate(&StatisticsShard::d_ops_ok, i);
+    std::cout << "  " << d_op_kinds[i] << ": " << n << " (" << n_ok << ")"
+              << std::endl;
+    sum += n;
+    sum_ok += n_ok;
   }
   std::cout << "  Total: " << sum << " (" << sum_ok << ")" << std::endl;
 
@@ -66,12 +234,81 @@ Statistics::print() const
   std::cout << "Sorts:" << std::endl;
   for (uint32_t i = 0; i < SORT_ANY; ++i)
   {
-    std::cout << "  " << static_cast<SortKind>(i) << ": " << d_sorts[i] << " ("
-              << d_sorts_ok[i] << ")" << std::endl;
-    sum += d_sorts[i];
-    sum_ok += d_sorts_ok[i];
+    uint64_t n    = aggregate(&StatisticsShard::d_sorts, i);
+    uint64_t n_ok = aggregate(&StatisticsShard::d_sorts_ok, i);
+    std::cout << "  " << static_cast<SortKind>(i) << ": " << n << " (" << n_ok
+              << ")" << std::endl;
+    sum += n;
+    sum_ok += n_ok;
   }
   std::cout << "  Total: " << sum << " (" << sum_ok << ")" << std::endl;
+
+  uint64_t total_ns = 0, total_ns_solver = 0;
+  std::cout << "Action latencies:" << std::endl;
+  for (uint32_t i = 0; i < MURXLA_MAX_N_ACTIONS && d_action_kinds[i][0]; ++i)
+  {
+    uint64_t ns;
+    auto buckets = aggregate(&StatisticsShard::d_action_times, i, ns);
+    print_latency(d_action_kinds[i], buckets, ns);
+    total_ns += ns;
+  }
+  std::cout << "  Total: " << format_ns(static_cast<double>(total_ns))
+            << std::endl;
+
+  std::cout << "Op latencies (mk_term):" << std::endl;
+  for (uint32_t i = 0; i < MURXLA_MAX_N_OPS && d_op_kinds[i][0]; ++i)
+  {
+    uint64_t ns;
+    auto buckets = aggregate(&StatisticsShard::d_op_times, i, ns);
+    print_latency(d_op_kinds[i], buckets, ns);
+    total_ns_solver += ns;
+  }
+  std::cout << "  Total: "
+            << format_ns(static_cast<double>(total_ns_solver)) << std::endl;
+}
+
+nlohmann::json
+Statistics::to_json() const
+{
+  nlohmann::json res;
+
+  for (uint32_t i = 0; i < MURXLA_MAX_N_STATES && d_state_kinds[i][0]; ++i)
+  {
+    res["states"][d_state_kinds[i]] = aggregate(&StatisticsShard::d_states, i);
+  }
+  for (uint32_t i = 0; i < MURXLA_MAX_N_ACTIONS && d_action_kinds[i][0]; ++i)
+  {
+    uint64_t ns;
+    auto buckets = aggregate(&StatisticsShard::d_action_times, i, ns);
+    nlohmann::json& j = res["actions"][d_action_kinds[i]];
+    j["count"]        = aggregate(&StatisticsShard::d_actions, i);
+    j["ok"]           = aggregate(&StatisticsShard::d_actions_ok, i);
+    j["latency"]      = latency_to_json(buckets, ns);
+  }
+  for (uint32_t i = 0; i < 3; ++i)
+  {
+    std::stringstream ss;
+    ss << static_cast<Solver::Result>(i);
+    res["results"][ss.str()] = aggregate(&StatisticsShard::d_results, i);
+  }
+  for (uint32_t i = 0; i < MURXLA_MAX_N_OPS && d_op_kinds[i][0]; ++i)
+  {
+    uint64_t ns;
+    auto buckets = aggregate(&StatisticsShard::d_op_times, i, ns);
+    nlohmann::json& j = res["ops"][d_op_kinds[i]];
+    j["count"]        = aggregate(&StatisticsShard::d_ops, i);
+    j["ok"]           = aggregate(&StatisticsShard::d_ops_ok, i);
+    j["latency"]      = latency_to_json(buckets, ns);
+  }
+  for (uint32_t i = 0; i < SORT_ANY; ++i)
+  {
+    std::stringstream ss;
+    ss << static_cast<SortKind>(i);
+    nlohmann::json& j = res["sorts"][ss.str()];
+    j["count"]        = aggregate(&StatisticsShard::d_sorts, i);
+    j["ok"]           = aggregate(&StatisticsShard::d_sorts_ok, i);
+  }
+  return res;
 }
 
 }  // namespace statistics
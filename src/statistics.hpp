@@ -10,6 +10,12 @@
 #ifndef __MURXLA__STATISTICS_H
 #define __MURXLA__STATISTICS_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <vector>
+
 #include "config.hpp"
 #include "op.hpp"
 
@@ -17,27 +23,194 @@ namespace murxla {
 
 namespace statistics {
 
+/**
+ * A statistics counter.
+ *
+ * Counters are only incremented by the worker process that owns the shard
+ * they belong to, but may be read concurrently by the parent process.  A
+ * relaxed load/store pair is thus sufficient for incrementing (no locked
+ * read-modify-write instruction needed), while readers never see torn values.
+ */
+class Counter
+{
+ public:
+  Counter& operator++()
+  {
+    add(1);
+    return *this;
+  }
+  void add(uint64_t n)
+  {
+    d_value.store(d_value.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+  operator uint64_t() const { return d_value.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> d_value{0};
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "statistics counters in shared memory must be lock-free");
+
+/** A log-scale latency histogram (see MURXLA_STATS_N_BUCKETS). */
+struct Histogram
+{
+  /** Record given latency in nanoseconds. */
+  void add(uint64_t ns);
+
+  Counter d_buckets[MURXLA_STATS_N_BUCKETS];
+  /** The sum of all recorded latencies in nanoseconds. */
+  Counter d_total_ns;
+};
+
+/** Record the lifetime of this object in the given histogram. */
+class ScopedTimer
+{
+ public:
+  ScopedTimer(Histogram& hist)
+      : d_hist(hist), d_start(std::chrono::steady_clock::now())
+  {
+  }
+  ~ScopedTimer()
+  {
+    d_hist.add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - d_start)
+                   .count());
+  }
+
+ private:
+  Histogram& d_hist;
+  std::chrono::steady_clock::time_point d_start;
+};
+
+/**
+ * The statistics of one worker process.
+ *
+ * Shards are aligned to cache lines to avoid false sharing between workers.
+ */
+struct alignas(MURXLA_CACHE_LINE_SIZE) StatisticsShard
+{
+  Counter d_results[3];
+  Counter d_ops[MURXLA_MAX_N_OPS];
+  Counter d_ops_ok[MURXLA_MAX_N_OPS];
+  Counter d_sorts[SORT_ANY];
+  Counter d_sorts_ok[SORT_ANY];
+  Counter d_states[MURXLA_MAX_N_STATES];
+  Counter d_actions[MURXLA_MAX_N_ACTIONS];
+  Counter d_actions_ok[MURXLA_MAX_N_ACTIONS];
+  /** The latencies of Action::generate() per action kind. */
+  Histogram d_action_times[MURXLA_MAX_N_ACTIONS];
+  /** The latencies of Solver::mk_term() per operator kind. */
+  Histogram d_op_times[MURXLA_MAX_N_OPS];
+
+  /**
+   * The id of the action that is currently executed by the test run, -1 if
+   * no action was executed yet.  Used to attribute timeouts to the action
+   * the solver hangs in.
+   */
+  int32_t d_cur_action = -1;
+  /**
+   * The id of the operator of the term that is currently created by the test
+   * run, -1 if the current action does not create a term.
+   */
+  int32_t d_cur_op = -1;
+  /** The number of actions executed by the test run so far. */
+  uint64_t d_cur_action_idx = 0;
+
+  /** Reset the in-flight action information before a test run. */
+  void reset_cur();
+  /** Set the action that is about to be executed by the test run. */
+  void set_cur_action(uint64_t id);
+  /** Set the operator of the term that is about to be created. */
+  void set_cur_op(uint64_t id);
+};
+
 /**
  * Statistics.
  *
  * The main statistics object is located in shared memory. We thus only use
- * base types here.
+ * base types here.  Counters are sharded per worker process, see shard().
+ * The kind names are registered once and shared by all shards.
  */
 struct Statistics
 {
-  uint64_t d_results[3];
+  /**
+   * Create statistics object in shared memory.
+   * @param n_shards  The number of shards, i.e., the maximum number of worker
+   *                  processes that record statistics concurrently.
+   */
+  static Statistics* create(uint32_t n_shards);
+  /**
+   * Release statistics object created via create().
+   * @return  0 on success, -1 otherwise.
+   */
+  static int32_t destroy(Statistics* stats);
+
+  /**
+   * Set the worker of this process.  Child processes inherit the worker of
+   * their parent.
+   */
+  static void set_worker(uint32_t worker) { s_worker = worker; }
+
+  /** Get the shard of the worker of this process. */
+  StatisticsShard& shard() { return d_shards[s_worker % d_n_shards]; }
+
+  /** Get the number of check-sat calls with given result over all shards. */
+  uint64_t get_num_results(uint32_t result) const;
+  /** Get the number of runs of the action with given id over all shards. */
+  uint64_t get_num_actions(uint64_t id) const;
+  /** Get the number of mk_term calls with the op of given id. */
+  uint64_t get_num_ops(uint64_t id) const;
+
   char d_op_kinds[MURXLA_MAX_N_OPS][MURXLA_MAX_KIND_LEN];
-  uint64_t d_ops[MURXLA_MAX_N_OPS];
-  uint64_t d_ops_ok[MURXLA_MAX_N_OPS];
-  uint64_t d_sorts[SORT_ANY];
-  uint64_t d_sorts_ok[SORT_ANY];
   char d_state_kinds[MURXLA_MAX_N_STATES][MURXLA_MAX_KIND_LEN];
-  uint64_t d_states[MURXLA_MAX_N_STATES];
   char d_action_kinds[MURXLA_MAX_N_ACTIONS][MURXLA_MAX_KIND_LEN];
-  uint64_t d_actions[MURXLA_MAX_N_ACTIONS];
-  uint64_t d_actions_ok[MURXLA_MAX_N_ACTIONS];
 
+  /** Print the statistics aggregated over all shards. */
   void print() const;
+  /** Get the statistics aggregated over all shards in JSON format. */
+  nlohmann::json to_json() const;
+
+ private:
+  /** Sum up the counters at index 'i' of all shards. */
+  template <size_t N>
+  uint64_t aggregate(Counter (StatisticsShard::*counters)[N], size_t i) const
+  {
+    uint64_t res = 0;
+    for (uint32_t s = 0; s < d_n_shards; ++s)
+    {
+      res += (d_shards[s].*counters)[i];
+    }
+    return res;
+  }
+  /** Sum up the histograms at index 'i' of all shards. */
+  template <size_t N>
+  std::vector<uint64_t> aggregate(Histogram (StatisticsShard::*hists)[N],
+                                  size_t i,
+                                  uint64_t& total_ns) const
+  {
+    std::vector<uint64_t> res(MURXLA_STATS_N_BUCKETS);
+    total_ns = 0;
+    for (uint32_t s = 0; s < d_n_shards; ++s)
+    {
+      const Histogram& h = (d_shards[s].*hists)[i];
+      for (size_t b = 0; b < MURXLA_STATS_N_BUCKETS; ++b)
+      {
+        res[b] += h.d_buckets[b];
+      }
+      total_ns += h.d_total_ns;
+    }
+    return res;
+  }
+
+  /** The worker of this process. */
+  inline static uint32_t s_worker = 0;
+
+  /** The number of shards. */
+  uint32_t d_n_shards = 0;
+  /** The shards, located in the same shared memory region. */
+  StatisticsShard* d_shards = nullptr;
 };
 
 }  // namespace statistics
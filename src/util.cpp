@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -653,4 +654,267 @@ rstrip(std::string& s)
 
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+/** The minimum length of a match for lz_compress(). */
+constexpr size_t LZ_MIN_MATCH = 4;
+/** The maximum offset of a match for lz_compress(). */
+constexpr size_t LZ_MAX_OFFSET = 65535;
+/** The number of bits of the hash table of lz_compress(). */
+constexpr size_t LZ_HASH_BITS = 16;
+
+uint32_t
+lz_read32(const std::string& s, size_t pos)
+{
+  uint32_t res;
+  std::memcpy(&res, s.data() + pos, sizeof(res));
+  return res;
+}
+
+void
+lz_write_length(std::string& out, size_t len)
+{
+  for (; len >= 255; len -= 255)
+  {
+    out.push_back(static_cast<char>(255));
+  }
+  out.push_back(static_cast<char>(len));
+}
+
+bool
+lz_read_length(const std::string& in, size_t& pos, size_t& len)
+{
+  uint8_t b;
+  do
+  {
+    if (pos >= in.size()) return false;
+    b = static_cast<uint8_t>(in[pos++]);
+    len += b;
+  } while (b == 255);
+  return true;
+}
+
+void
+lz_write_sequence(std::string& out,
+                  const std::string& in,
+                  size_t lit_begin,
+                  size_t lit_len,
+                  size_t offset,
+                  size_t match_len)
+{
+  size_t match_code = match_len ? match_len - LZ_MIN_MATCH : 0;
+  uint8_t token     = static_cast<uint8_t>((std::min<size_t>(lit_len, 15) << 4)
+                                       | std::min<size_t>(match_code, 15));
+  out.push_back(static_cast<char>(token));
+  if (lit_len >= 15) lz_write_length(out, lit_len - 15);
+  out.append(in, lit_begin, lit_len);
+  if (match_len)
+  {
+    out.push_back(static_cast<char>(offset & 0xff));
+    out.push_back(static_cast<char>(offset >> 8));
+    if (match_code >= 15) lz_write_length(out, match_code - 15);
+  }
+}
+
+}  // namespace
+
+std::string
+lz_compress(const std::string& in)
+{
+  std::string out;
+  std::vector<uint32_t> table(1 << LZ_HASH_BITS, 0);
+  size_t n = in.size(), pos = 0, anchor = 0;
+
+  out.reserve(n / 2 + 16);
+  while (pos + LZ_MIN_MATCH <= n)
+  {
+    uint32_t seq  = lz_read32(in, pos);
+    uint32_t hash = (seq * 2654435761u) >> (32 - LZ_HASH_BITS);
+    /* Positions are stored + 1, 0 means empty. */
+    size_t cand = table[hash];
+    table[hash] = static_cast<uint32_t>(pos + 1);
+
+    if (cand == 0 || pos + 1 - cand > LZ_MAX_OFFSET
+        || lz_read32(in, cand - 1) != seq)
+    {
+      ++pos;
+      continue;
+    }
+    cand -= 1;
+    size_t len = LZ_MIN_MATCH;
+    while (pos + len < n && in[cand + len] == in[pos + len])
+    {
+      ++len;
+    }
+    lz_write_sequence(out, in, anchor, pos - anchor, pos - cand, len);
+    pos += len;
+    anchor = pos;
+  }
+  lz_write_sequence(out, in, anchor, n - anchor, 0, 0);
+  return out;
+}
+
+bool
+lz_decompress(const std::string& in, std::string& out)
+{
+  size_t pos = 0;
+  out.clear();
+  while (pos < in.size())
+  {
+    uint8_t token  = static_cast<uint8_t>(in[pos++]);
+    size_t lit_len = token >> 4;
+    if (lit_len == 15 && !lz_read_length(in, pos, lit_len)) return false;
+    if (pos + lit_len > in.size()) return false;
+    out.append(in, pos, lit_len);
+    pos += lit_len;
+    /* The last sequence only consists of literals. */
+    if (pos == in.size()) break;
+
+    if (pos + 2 > in.size()) return false;
+    size_t offset = static_cast<uint8_t>(in[pos])
+                    | (static_cast<size_t>(static_cast<uint8_t>(in[pos + 1]))
+                       << 8);
+    pos += 2;
+    size_t match_len = token & 0xf;
+    if (match_len == 15 && !lz_read_length(in, pos, match_len)) return false;
+    match_len += LZ_MIN_MATCH;
+    if (offset == 0 || offset > out.size()) return false;
+
+    /* Matches may overlap with the bytes they produce. */
+    size_t from = out.size() - offset;
+    for (size_t i = 0; i < match_len; ++i)
+    {
+      out.push_back(out[from + i]);
+    }
+  }
+  return true;
+}
+
+uint64_t
+fnv1a_hash(const std::string& s)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : s)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/** Return true if given token is a sort or term id, e.g., 's12' or 't3'. */
+bool
+is_id(const std::string& token, char prefix)
+{
+  return token.size() > 1 && token[0] == prefix
+         && std::all_of(token.begin() + 1, token.end(), [](unsigned char c) {
+              return std::isdigit(c);
+            });
+}
+
+/**
+ * Get the canonical name for given sort id, term id or symbol, the canonical
+ * names are numbered in order of first occurrence.
+ */
+std::string
+get_canonical_name(std::unordered_map<std::string, std::string>& names,
+                   const std::string& name,
+                   const std::string& prefix)
+{
+  auto it = names.find(name);
+  if (it == names.end())
+  {
+    it = names.emplace(name, prefix + std::to_string(names.size() + 1)).first;
+  }
+  return it->second;
+}
+
+}  // namespace
+
+std::string
+canonicalize_trace(const std::string& trace_file_name)
+{
+  std::unordered_map<std::string, std::string> sorts, terms, symbols;
+  std::ifstream trace = open_input_file(trace_file_name, false);
+  std::stringstream res;
+  std::string line;
+
+  while (std::getline(trace, line))
+  {
+    if (line.empty() || line[0] == '#') continue;
+    if (line.rfind("set-murxla-options", 0) == 0)
+    {
+      res << line << "\n";
+      continue;
+    }
+
+    const auto& [seed, id, tokens] = tokenize(line);
+    /* Strings of values are not symbols. */
+    bool is_value = id == "mk-value" || id == "mk-special-value";
+    /* Uninterpreted sort symbols are traced without quotes. */
+    bool is_usort = id == "mk-sort" && !tokens.empty()
+                    && tokens[0] == "SORT_UNINTERPRETED";
+
+    res << id;
+    for (size_t i = 0, n = tokens.size(); i < n; ++i)
+    {
+      const std::string& token = tokens[i];
+      size_t len               = token.size();
+      res << " ";
+      if (is_id(token, 's'))
+      {
+        res << get_canonical_name(sorts, token, "s");
+      }
+      else if (is_id(token, 't'))
+      {
+        res << get_canonical_name(terms, token, "t");
+      }
+      else if (is_usort && i > 0)
+      {
+        res << get_canonical_name(symbols, token, "_s");
+      }
+      else if (!is_value && len > 1 && token[0] == '"' && token[len - 1] == '"')
+      {
+        res << "\""
+            << get_canonical_name(symbols, token.substr(1, len - 2), "_s")
+            << "\"";
+      }
+      /* Unresolved datatype sorts, e.g., 's<"_dt0">'. */
+      else if (len > 5 && token.compare(0, 3, "s<\"") == 0
+               && token.compare(len - 2, 2, "\">") == 0)
+      {
+        res << "s<\""
+            << get_canonical_name(symbols, token.substr(3, len - 5), "_s")
+            << "\">";
+      }
+      /* Datatype parameter sorts, e.g., 's"_p1"'. */
+      else if (len > 3 && token.compare(0, 2, "s\"") == 0
+               && token[len - 1] == '"')
+      {
+        res << "s\""
+            << get_canonical_name(symbols, token.substr(2, len - 3), "_s")
+            << "\"";
+      }
+      else
+      {
+        res << token;
+      }
+    }
+    res << "\n";
+  }
+  return res.str();
+}
+
+uint64_t
+canonical_trace_hash(const std::string& trace_file_name)
+{
+  return fnv1a_hash(canonicalize_trace(trace_file_name));
+}
+
+/* -------------------------------------------------------------------------- */
+
 }  // namespace murxla
@@ -146,6 +146,45 @@ std::string& rstrip(std::string& s);
 
 /* -------------------------------------------------------------------------- */
 
+/**
+ * Compress given string with a simple LZ77 codec in the style of the LZ4
+ * block format.
+ *
+ * A compressed block is a sequence of sequences, each consisting of a token
+ * byte (high nibble: number of literals, low nibble: match length - 4), the
+ * literals, and a 2-byte little endian match offset.  Lengths >= 15 are
+ * continued in bytes of 255 and a final byte < 255.  The last sequence only
+ * consists of literals.
+ */
+std::string lz_compress(const std::string& in);
+
+/**
+ * Decompress block 'in' compressed with lz_compress() into 'out'.
+ * Returns false if the block is corrupted.
+ */
+bool lz_decompress(const std::string& in, std::string& out);
+
+/** Compute the 64-bit FNV-1a hash of given string. */
+uint64_t fnv1a_hash(const std::string& s);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Get the canonical form of given trace file.
+ *
+ * Traces that differ only in the solver seeds of their lines, the names of
+ * symbols picked via SolverManager::pick_symbol() and the numbering of sort
+ * and term ids have the same canonical form.  Comment lines are dropped,
+ * seeds are stripped, sort and term ids are renumbered in order of their
+ * definition and symbols in order of their first occurrence.
+ */
+std::string canonicalize_trace(const std::string& trace_file_name);
+
+/** Compute the hash of the canonical form of given trace file. */
+uint64_t canonical_trace_hash(const std::string& trace_file_name);
+
+/* -------------------------------------------------------------------------- */
+
 template <typename T, typename P>
 T
 checked_cast(P* ptr)
@@ -1,9 +1,31 @@
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 #include "gtest/gtest.h"
 #include "util.hpp"
 
 using namespace murxla;
 
+namespace {
+
+/** Write given trace to a temporary file and return its canonical form. */
+std::string
+canonicalize(const std::string& trace)
+{
+  std::string file_name =
+      (std::filesystem::temp_directory_path() / "murxla-testutil.trace")
+          .string();
+  {
+    std::ofstream out(file_name);
+    out << trace;
+  }
+  std::string res = canonicalize_trace(file_name);
+  std::filesystem::remove(file_name);
+  return res;
+}
+
+}  // namespace
+
 TEST(util, str_bin_to_hex)
 {
   ASSERT_EQ(str_bin_to_hex("0"), "0");
@@ -301,3 +323,99 @@ TEST(util, is_bv_special_value_max_signed_str)
     for (uint32_t j = 1; i > 0 && j < n; ++j) ASSERT_EQ(s[j], '1');
   }
 }
+
+TEST(util, lz_compress)
+{
+  std::vector<std::string> inputs = {
+      "",
+      "a",
+      "(assert (= x y))",
+      std::string(1000, 'x'),
+  };
+  std::string s;
+  for (uint32_t i = 0; i < 5000; ++i)
+  {
+    s += "(declare-const x" + std::to_string(i % 97) + " Int)\n";
+  }
+  inputs.push_back(s);
+
+  for (const auto& in : inputs)
+  {
+    std::string compressed = lz_compress(in), out;
+    ASSERT_TRUE(lz_decompress(compressed, out));
+    ASSERT_EQ(in, out);
+  }
+  ASSERT_LT(lz_compress(s).size(), s.size() / 4);
+  std::string out;
+  ASSERT_FALSE(lz_decompress(std::string(1, '\xf0'), out));
+}
+
+TEST(util, canonicalize_trace)
+{
+  std::string trace =
+      "set-murxla-options --smt2\n"
+      "# comment\n"
+      "91750 new\n"
+      "90318 mk-sort SORT_BV 8\n"
+      "      return s4\n"
+      "12345 mk-const s4 \"_x7\"\n"
+      "      return t9\n"
+      "54321 mk-term OP_BV_ADD s4 2 t9 t9\n"
+      "      return t12\n";
+  ASSERT_EQ(canonicalize(trace),
+            "set-murxla-options --smt2\n"
+            "new\n"
+            "mk-sort SORT_BV 8\n"
+            "return s1\n"
+            "mk-const s1 \"_s1\"\n"
+            "return t1\n"
+            "mk-term OP_BV_ADD s1 2 t1 t1\n"
+            "return t2\n");
+
+  /* Seeds, sort and term ids and symbols do not matter. */
+  ASSERT_EQ(canonicalize(trace),
+            canonicalize("set-murxla-options --smt2\n"
+                         "1 new\n"
+                         "2 mk-sort SORT_BV 8\n"
+                         "  return s2\n"
+                         "3 mk-const s2 \"|a b|\"\n"
+                         "  return t3\n"
+                         "4 mk-term OP_BV_ADD s2 2 t3 t3\n"
+                         "  return t4\n"));
+  /* Their structure does. */
+  ASSERT_NE(canonicalize("1 mk-const s1 \"x\"\n2 mk-const s1 \"x\"\n"),
+            canonicalize("1 mk-const s1 \"x\"\n2 mk-const s1 \"y\"\n"));
+  ASSERT_NE(canonicalize("1 mk-term OP_AND s1 2 t1 t1\n"),
+            canonicalize("1 mk-term OP_AND s1 2 t1 t2\n"));
+
+  /* Uninterpreted sort names are symbols. */
+  ASSERT_EQ(canonicalize("1 mk-sort SORT_UNINTERPRETED _u1\n"
+                         "2 mk-const s1 \"_u1\"\n"),
+            canonicalize("3 mk-sort SORT_UNINTERPRETED foo\n"
+                         "4 mk-const s2 \"foo\"\n"));
+  ASSERT_NE(canonicalize("1 mk-sort SORT_UNINTERPRETED _u1\n"
+                         "2 mk-const s1 \"_u1\"\n"),
+            canonicalize("3 mk-sort SORT_UNINTERPRETED foo\n"
+                         "4 mk-const s2 \"bar\"\n"));
+
+  /* Datatype names, unresolved datatype sorts and parameter sorts. */
+  std::string dt =
+      "1 mk-sort SORT_DT 2 \"_dt0\" 1 s\"_p1\" 1 \"_c2\" 2 \"_s3\" s\"_p1\" "
+      "\"_s4\" s<\"_dt5\"> 0 \"_dt5\" 0 1 \"_c6\" 0\n";
+  ASSERT_EQ(canonicalize(dt),
+            "mk-sort SORT_DT 2 \"_s1\" 1 s\"_s2\" 1 \"_s3\" 2 \"_s4\" s\"_s2\" "
+            "\"_s5\" s<\"_s6\"> 0 \"_s6\" 0 1 \"_s7\" 0\n");
+  ASSERT_EQ(canonicalize(dt),
+            canonicalize("2 mk-sort SORT_DT 2 \"d\" 1 s\"p\" 1 \"c\" 2 "
+                         "\"s\" s\"p\" \"t\" s<\"e\"> 0 \"e\" 0 1 \"f\" 0\n"));
+  ASSERT_NE(canonicalize(dt),
+            canonicalize("2 mk-sort SORT_DT 2 \"d\" 1 s\"p\" 1 \"c\" 2 "
+                         "\"s\" s\"q\" \"t\" s<\"e\"> 0 \"e\" 0 1 \"f\" 0\n"));
+
+  /* Strings of values are not symbols. */
+  ASSERT_EQ(canonicalize("1 mk-value s1 \"abc\"\n"), "mk-value s1 \"abc\"\n");
+  ASSERT_NE(canonicalize("1 mk-value s1 \"abc\"\n"),
+            canonicalize("1 mk-value s1 \"abd\"\n"));
+  ASSERT_NE(canonicalize("1 mk-special-value s1 \"+oo\"\n"),
+            canonicalize("1 mk-special-value s1 \"-oo\"\n"));
+}